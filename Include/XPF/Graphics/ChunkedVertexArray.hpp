@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_CHUNKEDVERTEXARRAY_HPP
+#define SFML_CHUNKEDVERTEXARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/Graphics/Drawable.hpp>
+#include <XPF/Graphics/PrimitiveType.hpp>
+#include <XPF/Graphics/Rect.hpp>
+#include <XPF/Graphics/Vertex.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Vertex array split into chunks, so that the parts outside of the view can be skipped
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ChunkedVertexArray : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty vertex array.
+    ///
+    ////////////////////////////////////////////////////////////
+    ChunkedVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex array with a type and an initial number of vertices
+    ///
+    /// The chunk size is rounded up to a multiple of 12, so that
+    /// chunks never split a line, a triangle or a quad.
+    ///
+    /// \param type        Type of primitives
+    /// \param vertexCount Initial number of vertices in the array
+    /// \param chunkSize   Number of vertices per chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ChunkedVertexArray(PrimitiveType type, std::size_t vertexCount = 0, std::size_t chunkSize = 1536);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the vertex count
+    ///
+    /// \return Number of vertices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of vertices per chunk
+    ///
+    /// \return Number of vertices in each chunk (except the last one)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChunkSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of chunks
+    ///
+    /// \return Number of chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChunkCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-write access to a vertex by its index
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getVertexCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// Calling this function marks the chunk of the vertex as
+    /// modified. If the returned reference is kept and written
+    /// after the array was drawn or its bounds were computed,
+    /// invalidateBounds must be called for the change to be
+    /// taken into account.
+    ///
+    /// \param index Index of the vertex to get
+    ///
+    /// \return Reference to the index-th vertex
+    ///
+    /// \see getVertexCount, invalidateBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex& operator [](std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only access to a vertex by its index
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getVertexCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index Index of the vertex to get
+    ///
+    /// \return Const reference to the index-th vertex
+    ///
+    /// \see getVertexCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vertex& operator [](std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the vertex array
+    ///
+    /// This function removes all the vertices from the array.
+    /// It doesn't deallocate the corresponding memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the vertex array
+    ///
+    /// \param vertexCount New size of the array (number of vertices)
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a vertex to the array
+    ///
+    /// \param vertex Vertex to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Vertex& vertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the type of primitives to draw
+    ///
+    /// \param type Type of primitive
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrimitiveType(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of primitives drawn by the vertex array
+    ///
+    /// \return Primitive type
+    ///
+    ////////////////////////////////////////////////////////////
+    PrimitiveType getPrimitiveType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the bounds of all the chunks as outdated
+    ///
+    /// Call this function after writing vertices through references
+    /// kept from a previous call to operator [], so that the bounds
+    /// are computed again before the next draw.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateBounds();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounding rectangle of the vertex array
+    ///
+    /// \return Bounding rectangle of the vertex array
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices shared with the previous chunk
+    ///
+    /// \return 1 for line strips, 2 for triangle strips, 0 otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getOverlap() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the chunks containing a vertex as modified
+    ///
+    /// \param index Index of the modified vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the chunk tables to match the vertex count
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunkCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounding rectangles of the modified chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureBoundsUpdate() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vertex>            m_vertices;         ///< Vertices contained in the array
+    PrimitiveType                  m_primitiveType;    ///< Type of primitives to draw
+    std::size_t                    m_chunkSize;        ///< Number of vertices per chunk
+    mutable std::vector<FloatRect> m_chunkBounds;      ///< Bounding rectangle of each chunk
+    mutable std::vector<bool>      m_chunkNeedUpdate;  ///< Must the bounds of each chunk be computed again?
+    mutable bool                   m_boundsNeedUpdate; ///< Is any chunk modified?
+};
+
+} // namespace sf
+
+
+#endif // SFML_CHUNKEDVERTEXARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ChunkedVertexArray
+/// \ingroup graphics
+///
+/// sf::ChunkedVertexArray has the same interface as
+/// sf::VertexArray, but it splits its vertices into chunks
+/// of fixed size and keeps a bounding rectangle for each
+/// of them. When view culling is enabled on the render target
+/// (see sf::RenderTarget::setCullingEnabled), the chunks that
+/// are entirely outside of the view are skipped, and the
+/// visible ones are drawn with one call per contiguous run.
+///
+/// It is meant for large meshes (tile maps, terrains...)
+/// of which only a part is visible at a time; the vertices
+/// should be ordered so that spatially close primitives are
+/// close in the array, for example row by row. The bounds of
+/// a chunk are only computed again after one of its vertices
+/// was accessed for writing; vertices written later through
+/// a kept reference require a call to invalidateBounds.
+///
+/// Triangle fans can't be split, they are always drawn as
+/// a whole.
+///
+/// Example:
+/// \code
+/// sf::ChunkedVertexArray map(sf::Quads, width * height * 4);
+/// // ... fill the quads row by row ...
+///
+/// window.setCullingEnabled(true);
+/// window.draw(map, &tileset);
+/// \endcode
+///
+/// \see sf::VertexArray, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
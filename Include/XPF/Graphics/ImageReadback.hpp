@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEREADBACK_HPP
+#define SFML_IMAGEREADBACK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/Graphics/Image.hpp>
+#include <XPF/Window/GlResource.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <XPF/System/Vector2.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Pending copy of pixels from the graphics card to an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageReadback : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an idle readback.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a copy was started and not retrieved yet
+    ///
+    /// \return True if getImage has an image to return
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pending copy is complete
+    ///
+    /// This function doesn't wait for the graphics card, it
+    /// is meant to be called once per frame until it returns
+    /// true.
+    ///
+    /// \return True if getImage can be called without stalling
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the copied pixels
+    ///
+    /// If the copy is not complete yet, this function waits
+    /// for it. The readback is idle again after this call,
+    /// and can be reused for another copy.
+    ///
+    /// \param image Image to fill with the copied pixels
+    ///
+    /// \return True if an image was retrieved, false if no copy was pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImage(Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether asynchronous readbacks are supported
+    ///
+    /// They require pixel buffer objects (OpenGL 2.1). When they
+    /// are not supported, copies are performed synchronously
+    /// when they are started, and isReady() is always true.
+    ///
+    /// \return True if copies are asynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    friend class Texture;
+    friend class RenderWindow;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare the pixel buffer receiving a copy
+    ///
+    /// The pixel buffer is left bound, so that the caller can
+    /// issue the OpenGL read command right after.
+    ///
+    /// \param size       Size of the final image
+    /// \param sourceSize Size of the pixels read by OpenGL (can be padded)
+    /// \param flipped    Are the source rows stored bottom to top?
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginRead(const Vector2u& size, const Vector2u& sourceSize, bool flipped);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the pixel buffer and insert the fence that tracks the copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void endRead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store an image copied synchronously
+    ///
+    /// \param image Copied image
+    ///
+    ////////////////////////////////////////////////////////////
+    void setImage(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the fence of the current copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteFence();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer;     ///< Pixel buffer object receiving the pixels
+    void*        m_fence;      ///< Sync object signaled when the copy is complete (NULL if not supported)
+    Vector2u     m_size;       ///< Size of the final image
+    Vector2u     m_sourceSize; ///< Size of the pixels stored in the buffer
+    bool         m_flipped;    ///< Are the rows stored bottom to top?
+    bool         m_pending;    ///< Is there a copy to retrieve?
+    Image        m_image;      ///< Image copied synchronously, when pixel buffers are not supported
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEREADBACK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageReadback
+/// \ingroup graphics
+///
+/// Reading pixels back from the graphics card with
+/// sf::Texture::copyToImage or sf::RenderWindow::capture
+/// forces the CPU to wait until the GPU has finished all
+/// the pending rendering, which is a severe stall when done
+/// regularly (e.g. recording frames).
+///
+/// sf::ImageReadback lets the copy happen in the background:
+/// it is started with sf::Texture::copyToImageAsync or
+/// sf::RenderWindow::captureAsync, and the image is retrieved
+/// a frame or two later, once isReady() returns true. A
+/// readback can be reused for any number of copies; using a
+/// few of them in rotation allows starting a new copy before
+/// the previous one is retrieved.
+///
+/// The contents of a sf::RenderTexture can be read back
+/// through its texture, after calling display().
+///
+/// Usage example:
+/// \code
+/// sf::ImageReadback readback;
+///
+/// while (window.isOpen())
+/// {
+///     // ... draw and display ...
+///
+///     if (readback.isPending())
+///     {
+///         if (readback.isReady())
+///         {
+///             sf::Image frame;
+///             readback.getImage(frame);
+///             recorder.add(frame);
+///         }
+///     }
+///     else
+///     {
+///         window.captureAsync(readback);
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderWindow, sf::Image
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERQUEUE_HPP
+#define SFML_RENDERQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/Graphics/BlendMode.hpp>
+#include <XPF/Graphics/Drawable.hpp>
+#include <XPF/Graphics/PrimitiveType.hpp>
+#include <XPF/Graphics/RenderStates.hpp>
+#include <XPF/Graphics/Vertex.hpp>
+#include <XPF/System/Mutex.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Shader;
+class Texture;
+class VertexArray;
+
+////////////////////////////////////////////////////////////
+/// \brief Deferred list of draw commands, sorted by render states before being drawn
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderQueue : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied and transformed by \a states.transform,
+    /// so the array doesn't have to outlive the queue. Strips and
+    /// fans are converted to lists, so that consecutive commands
+    /// with the same states can be drawn together.
+    ///
+    /// This function can be called from several threads at once.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param layer       Layer of the command, in range [-32768, 32767]
+    /// \param depth       Order of the command among the commands of its layer that use the same states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+              const RenderStates& states = RenderStates::Default, int layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the contents of a vertex array
+    ///
+    /// \param vertices Vertex array to record
+    /// \param states   Render states to use for drawing
+    /// \param layer    Layer of the command, in range [-32768, 32767]
+    /// \param depth    Order of the command among the commands of its layer that use the same states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexArray& vertices, const RenderStates& states = RenderStates::Default, int layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record all the commands of another queue
+    ///
+    /// This is the way to merge the queues recorded by
+    /// different worker threads without locking on every command.
+    ///
+    /// \param queue Queue to append
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const RenderQueue& queue);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the commands of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of commands recorded in the queue
+    ///
+    /// \return Number of commands
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of draw calls needed to draw the queue
+    ///
+    /// This sorts the queue if it was modified since the last call.
+    ///
+    /// \return Number of draw calls
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBatchCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the queue to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the commands and merge them into batches if needed
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureSorted() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw command
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        const Texture* texture;   ///< Texture used by the command
+        const Shader*  shader;    ///< Shader used by the command
+        BlendMode      blendMode; ///< Blending mode of the command
+        PrimitiveType  type;      ///< Type of primitives (always a list type)
+        int            layer;     ///< Layer of the command
+        float          depth;     ///< Depth of the command inside its layer
+        std::size_t    first;     ///< Index of the first vertex in m_vertices
+        std::size_t    count;     ///< Number of vertices
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of sorted vertices drawn with a single draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        const Texture* texture;   ///< Texture of the batch
+        const Shader*  shader;    ///< Shader of the batch
+        BlendMode      blendMode; ///< Blending mode of the batch
+        PrimitiveType  type;      ///< Type of primitives of the batch
+        std::size_t    first;     ///< Index of the first vertex in m_sortedVertices
+        std::size_t    count;     ///< Number of vertices
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vertex>         m_vertices;       ///< Vertices of all the commands, in recording order
+    std::vector<Command>        m_commands;       ///< Recorded commands
+    mutable std::vector<Vertex> m_sortedVertices; ///< Vertices of all the commands, in drawing order
+    mutable std::vector<Batch>  m_batches;        ///< Draw calls to issue
+    mutable bool                m_needSort;       ///< Must the commands be sorted again?
+    mutable Mutex               m_mutex;          ///< Mutex protecting the recording
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderQueue
+/// \ingroup graphics
+///
+/// sf::RenderQueue records draw commands instead of executing
+/// them, and draws them later in an order that minimizes
+/// the changes of render states.
+///
+/// Every command has a layer: layers are drawn in increasing
+/// order, so they can be used for background, world, HUD, etc.
+/// Inside a layer, the commands are sorted by a key packing
+/// their shader, texture, blending mode and primitive type,
+/// then by depth; commands with the same key and depth keep
+/// their recording order. Consecutive commands that end up
+/// with the same render states are drawn with a single call.
+/// Since commands of different states are reordered inside a
+/// layer, overlapping translucent geometry that must be drawn
+/// in a specific order should use different layers.
+///
+/// The transform of the render states is applied to the
+/// vertices when they are recorded; the transform passed when
+/// the queue itself is drawn is applied on top of it. Shaders
+/// are used with the values of their uniforms at the time
+/// the queue is drawn.
+///
+/// Commands can be recorded from any thread, and from several
+/// threads at once; for large amounts of geometry it is
+/// faster to record into one queue per thread and merge them
+/// with append(). Drawing the queue must happen on the thread
+/// that owns the render target, while no other thread is
+/// recording into it.
+///
+/// Usage example:
+/// \code
+/// sf::RenderQueue queue;
+///
+/// // on any thread
+/// queue.draw(terrain, sf::RenderStates(&tiles), 0);
+/// queue.draw(vertices, count, sf::Triangles, sf::RenderStates(&units), 1);
+///
+/// // on the rendering thread
+/// window.draw(queue);
+/// queue.clear();
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
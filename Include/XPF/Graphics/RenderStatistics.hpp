@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERSTATISTICS_HPP
+#define SFML_RENDERSTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Counters describing the work done to render a frame
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderStatistics
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStatistics() : drawCalls(0), vertices(0), textureBinds(0), shaderBinds(0), blendModeChanges(0), viewChanges(0), gpuTime(), gpuTimeAvailable(false) {}
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int drawCalls;        ///< Number of draw calls sent to OpenGL
+    Uint64       vertices;         ///< Number of vertices drawn
+    unsigned int textureBinds;     ///< Number of texture changes
+    unsigned int shaderBinds;      ///< Number of shader activations
+    unsigned int blendModeChanges; ///< Number of blending mode changes
+    unsigned int viewChanges;      ///< Number of view (viewport and projection) changes
+    Time         gpuTime;          ///< Time spent by the graphics card to render the frame
+    bool         gpuTimeAvailable; ///< Is gpuTime valid?
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERSTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderStatistics
+/// \ingroup graphics
+///
+/// sf::RenderStatistics is returned by
+/// sf::RenderTarget::getStatistics. The counters are
+/// accumulated between two calls to display() and only count
+/// the work actually sent to OpenGL: draws merged by batching
+/// count as a single draw call, and draws skipped by culling
+/// are not counted at all.
+///
+/// Comparing the CPU time of a frame with \a gpuTime tells
+/// whether rendering is limited by the CPU or by the graphics
+/// card. The GPU time is measured with timer queries, which
+/// are read one frame late so that reading them never waits
+/// for the graphics card: the GPU time reported with the
+/// counters of a frame is the one of the frame before it.
+/// It is only available when timing is enabled with
+/// sf::RenderTarget::setGpuTimingEnabled and the driver
+/// supports timer queries.
+///
+/// Usage example:
+/// \code
+/// window.setGpuTimingEnabled(true);
+/// ...
+/// window.display();
+///
+/// const sf::RenderStatistics& stats = window.getStatistics();
+/// std::cout << stats.drawCalls << " draw calls, " << stats.vertices << " vertices";
+/// if (stats.gpuTimeAvailable)
+///     std::cout << ", " << stats.gpuTime.asMicroseconds() << " us on the GPU";
+/// std::cout << std::endl;
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
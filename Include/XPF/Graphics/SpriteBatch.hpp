@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/Graphics/Color.hpp>
+#include <XPF/Graphics/Drawable.hpp>
+#include <XPF/Graphics/Rect.hpp>
+#include <XPF/Graphics/Vertex.hpp>
+#include <XPF/System/Vector2.hpp>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Sprite;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable made of many textured quads, drawn with as few draw calls as possible
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites of the batch
+    ///
+    /// The memory is kept, so that refilling the batch every
+    /// frame doesn't allocate.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for a number of sprites
+    ///
+    /// \param spriteCount Number of sprites to reserve memory for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t spriteCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The parameters have the same meaning as the corresponding
+    /// properties of sf::Sprite and sf::Transformable.
+    ///
+    /// \param texture     Texture of the sprite (must stay alive as long as the batch uses it)
+    /// \param textureRect Sub-rectangle of the texture to display
+    /// \param position    Position of the sprite's origin
+    /// \param rotation    Rotation of the sprite, in degrees
+    /// \param scale       Scale factors of the sprite
+    /// \param color       Global color of the sprite
+    /// \param origin      Origin of the sprite's translation, rotation and scale, relative to its top-left corner
+    ///
+    /// \return Index of the sprite in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Texture& texture, const IntRect& textureRect, const Vector2f& position, float rotation = 0.f,
+                    const Vector2f& scale = Vector2f(1.f, 1.f), const Color& color = Color::White, const Vector2f& origin = Vector2f(0.f, 0.f));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of a sprite to the batch
+    ///
+    /// The sprite's texture must stay alive as long as the
+    /// batch uses it.
+    ///
+    /// \param sprite Sprite to add
+    ///
+    /// \return Index of the sprite in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Sprite& sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sprite from the batch
+    ///
+    /// The last sprite of the batch is moved to the index of
+    /// the removed one, so that removing is cheap: the index of
+    /// this last sprite changes, the others keep theirs.
+    ///
+    /// \param index Index of the sprite to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture of a sprite of the batch
+    ///
+    /// \param index   Index of the sprite, as returned by add
+    /// \param texture New texture (must stay alive as long as the batch uses it)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(std::size_t index, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture rectangle of a sprite of the batch
+    ///
+    /// \param index       Index of the sprite, as returned by add
+    /// \param textureRect New sub-rectangle of the texture to display
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(std::size_t index, const IntRect& textureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the position of a sprite of the batch
+    ///
+    /// \param index    Index of the sprite, as returned by add
+    /// \param position New position
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the rotation of a sprite of the batch
+    ///
+    /// \param index    Index of the sprite, as returned by add
+    /// \param rotation New rotation, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float rotation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the scale of a sprite of the batch
+    ///
+    /// \param index Index of the sprite, as returned by add
+    /// \param scale New scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& scale);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the origin of a sprite of the batch
+    ///
+    /// \param index  Index of the sprite, as returned by add
+    /// \param origin New origin, relative to the top-left corner of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the color of a sprite of the batch
+    ///
+    /// \param index Index of the sprite, as returned by add
+    /// \param color New color
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of a texture in the batch
+    ///
+    /// Identifiers are given in the order in which the textures
+    /// are first used, and define the order of the batches.
+    ///
+    /// \param texture Texture to identify
+    ///
+    /// \return Identifier of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextureId(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the sprites by texture and expand them to quads
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of vertices sharing the same texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        const Texture* texture; ///< Texture of the sprites
+        std::size_t    first;   ///< Index of the first vertex
+        std::size_t    count;   ///< Number of vertices
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<const Texture*>           m_textures;           ///< Texture of each sprite
+    std::vector<std::size_t>              m_textureIds;         ///< Identifier of the texture of each sprite, used to sort them
+    std::map<const Texture*, std::size_t> m_textureTable;       ///< Identifier of each texture used by the batch
+    std::vector<IntRect>                  m_textureRects;       ///< Texture rectangle of each sprite
+    std::vector<Vector2f>                 m_positions;          ///< Position of each sprite
+    std::vector<float>                    m_rotations;          ///< Rotation of each sprite, in degrees
+    std::vector<Vector2f>                 m_scales;             ///< Scale of each sprite
+    std::vector<Vector2f>                 m_origins;            ///< Origin of each sprite
+    std::vector<Color>                    m_colors;             ///< Color of each sprite
+    mutable std::vector<std::size_t>      m_order;              ///< Sprite indices sorted by texture
+    mutable std::vector<Vertex>           m_vertices;           ///< Expanded quads (two triangles per sprite), in m_order
+    mutable std::vector<Batch>            m_batches;            ///< Ranges of m_vertices sharing a texture
+    mutable bool                          m_orderNeedUpdate;    ///< Must the sprites be sorted again?
+    mutable bool                          m_geometryNeedUpdate; ///< Must the quads be expanded again?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws a large number of textured quads
+/// (particles, bullets, tiles...) much faster than the same
+/// number of sf::Sprite instances.
+///
+/// The properties of the sprites are stored as separate
+/// arrays (one per property), and all the quads are expanded
+/// in a single pass when the batch is drawn after being
+/// modified. The sprites are grouped by texture, so that
+/// drawing the batch issues only one draw call per texture.
+/// The textures are drawn in the order in which they were
+/// first used by the batch (since the last call to clear()),
+/// and within a texture the sprites are drawn in index order.
+///
+/// Sprites are identified by the index returned by add().
+/// A typical particle system either updates its sprites with
+/// the setters, or calls clear() and adds them again every
+/// frame; both are cheap. remove() moves the last sprite to
+/// the index of the removed one.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch bullets;
+/// for (std::size_t i = 0; i < count; ++i)
+///     bullets.add(texture, sf::IntRect(0, 0, 8, 8), positions[i], angles[i]);
+///
+/// window.draw(bullets);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
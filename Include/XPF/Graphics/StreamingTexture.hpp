@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STREAMINGTEXTURE_HPP
+#define SFML_STREAMINGTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/Graphics/Texture.hpp>
+#include <XPF/Window/GlResource.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Texture whose whole contents are replaced frequently
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API StreamingTexture : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty streaming texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture and its upload buffers
+    ///
+    /// If this function fails, the streaming texture is left
+    /// empty.
+    ///
+    /// \param width     Width of the texture
+    /// \param height    Height of the texture
+    /// \param slotCount Number of upload buffers (frames that can be in flight)
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int slotCount = 3);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get write access to the next upload buffer
+    ///
+    /// The returned array has the size of the texture and
+    /// contains 32-bits RGBA pixels, row by row from the top.
+    /// Its previous contents are undefined: all the pixels must
+    /// be written before calling commit().
+    ///
+    /// This function must be called from a thread where OpenGL
+    /// can be used (usually the rendering thread), but the
+    /// returned pointer can be written from any thread until
+    /// commit() is called.
+    ///
+    /// \return Pointer to the pixels to write, or NULL if the texture is empty
+    ///
+    /// \see commit
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* map();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the pixels written in the mapped buffer to the texture
+    ///
+    /// The transfer is performed by the graphics card while
+    /// rendering continues. The pointer returned by map() must
+    /// not be used after this call.
+    ///
+    /// \see map
+    ///
+    ////////////////////////////////////////////////////////////
+    void commit();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the texture
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the texture
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture to draw
+    ///
+    /// \return Texture containing the last committed pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the upload buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroyBuffers();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture                   m_texture; ///< Texture receiving the pixels
+    std::vector<unsigned int> m_buffers; ///< Ring of pixel unpack buffers (empty if not supported)
+    std::size_t               m_current; ///< Index of the buffer to map next
+    Uint8*                    m_mapped;  ///< Pixels of the mapped buffer (NULL if none)
+    std::vector<Uint8>        m_pixels;  ///< Client memory used instead of the buffers when they are not supported
+};
+
+} // namespace sf
+
+
+#endif // SFML_STREAMINGTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StreamingTexture
+/// \ingroup graphics
+///
+/// Updating a sf::Texture with sf::Texture::update copies the
+/// pixels synchronously from client memory, which blocks the
+/// rendering thread for every frame of a video or webcam
+/// stream.
+///
+/// sf::StreamingTexture owns a texture and a ring of pixel
+/// buffers allocated by the driver. Each frame is written
+/// directly into the next buffer of the ring (for example by
+/// the decoder) and then committed: the transfer to the
+/// texture happens on the graphics card, overlapping with
+/// rendering, and the ring makes sure that a buffer is not
+/// written while the previous transfer from it may still be
+/// in progress.
+///
+/// When pixel buffers are not supported, map() returns client
+/// memory and commit() performs a regular synchronous update.
+///
+/// Usage example:
+/// \code
+/// sf::StreamingTexture video;
+/// video.create(1920, 1080);
+///
+/// // ... every frame ...
+/// sf::Uint8* pixels = video.map();
+/// decoder.decodeFrame(pixels);
+/// video.commit();
+///
+/// window.draw(sf::Sprite(video.getTexture()));
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Export.hpp>
+#include <XPF/Graphics/Image.hpp>
+#include <XPF/Graphics/Rect.hpp>
+#include <XPF/Graphics/Texture.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Packs many images into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Handle
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an invalid handle (null texture).
+        ///
+        ////////////////////////////////////////////////////////////
+        Handle();
+
+        const Texture* texture;     ///< Page texture containing the image (NULL if the handle is invalid)
+        IntRect        textureRect; ///< Area of the image in the page texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty atlas.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image file to the atlas
+    ///
+    /// The image is loaded immediately, but it is only packed
+    /// into a texture by the next call to pack().
+    /// Adding an image with the name of an existing one replaces
+    /// it (the old image stays in its page, unused).
+    ///
+    /// \param name     Name used to retrieve the image later
+    /// \param filename Path of the image file to load
+    ///
+    /// \return True if the image was successfully loaded
+    ///
+    /// \see addFromMemory, addFromStream, addFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFromFile(const std::string& name, const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image file in memory to the atlas
+    ///
+    /// \param name Name used to retrieve the image later
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if the image was successfully loaded
+    ///
+    /// \see addFromFile, addFromStream, addFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFromMemory(const std::string& name, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image from a custom stream to the atlas
+    ///
+    /// \param name   Name used to retrieve the image later
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if the image was successfully loaded
+    ///
+    /// \see addFromFile, addFromMemory, addFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFromStream(const std::string& name, InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of an image to the atlas
+    ///
+    /// \param name  Name used to retrieve the image later
+    /// \param image Image to add
+    ///
+    /// \return True if the image was added, false if it is empty
+    ///
+    /// \see addFromFile, addFromMemory, addFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFromImage(const std::string& name, const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack all the images added since the last call into textures
+    ///
+    /// The images are sorted by height and packed in rows, into
+    /// new pages as large as the hardware allows (up to 4096x4096).
+    /// Existing pages are left untouched, so handles obtained
+    /// before the call remain valid.
+    ///
+    /// \param padding Number of transparent pixels left between two images
+    ///
+    /// \return True if all the images were packed, false if some were too large
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pack(unsigned int padding = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the packed atlas to files
+    ///
+    /// The layout is written to \a filename, and each page to
+    /// an image file named after it ("<filename>.0.png",
+    /// "<filename>.1.png", ...). Images that were not packed
+    /// yet are not saved.
+    ///
+    /// \param filename Path of the layout file to write
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an atlas previously saved with saveToFile
+    ///
+    /// The pages are loaded directly, without any packing.
+    /// They are added to the existing ones.
+    ///
+    /// \param filename Path of the layout file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location of a packed image
+    ///
+    /// \param name Name of the image, as given when adding it
+    ///
+    /// \return Handle to the image, invalid if there's no packed image with this name
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle getHandle(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of page textures of the atlas
+    ///
+    /// \return Number of pages
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a page texture of the atlas
+    ///
+    /// \param index Index of the page, in range [0 .. getPageCount() - 1]
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getPage(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on all the pages
+    ///
+    /// The setting also applies to pages created later.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and pages of the atlas
+    ///
+    /// All the handles obtained from the atlas become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of a packed image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        std::size_t page; ///< Index of the page containing the image
+        IntRect     rect; ///< Area of the image in the page
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::vector<std::pair<std::string, Image> > PendingImages; ///< Images waiting to be packed
+    typedef std::map<std::string, Region>                RegionTable;   ///< Packed images, by name
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    PendingImages       m_pending; ///< Images added since the last call to pack
+    std::deque<Texture> m_pages;   ///< Page textures (a deque keeps their addresses stable)
+    RegionTable         m_regions; ///< Location of the packed images
+    bool                m_smooth;  ///< Smooth filter applied to the pages
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Every sf::Texture is a separate OpenGL texture, and
+/// switching textures between two draw calls has a cost.
+/// sf::TextureAtlas packs many small images into a few large
+/// page textures, so that sprites and shapes using them share
+/// the same texture and can be drawn without rebinding.
+///
+/// Images are first added by name, then packed all at once
+/// with pack(). Each packed image is then accessed through a
+/// handle, which is made of a page texture and the area of
+/// the image in it; both can be given directly to sf::Sprite
+/// and sf::Shape.
+///
+/// Packing happens at runtime, but its result can be saved
+/// with saveToFile() and loaded back with loadFromFile() on
+/// the next run, which skips both the loading of the
+/// individual images and the packing.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+/// if (!atlas.loadFromFile("cache/sprites.atlas"))
+/// {
+///     atlas.addFromFile("player", "player.png");
+///     atlas.addFromFile("enemy", "enemy.png");
+///     atlas.pack();
+///     atlas.saveToFile("cache/sprites.atlas");
+/// }
+///
+/// sf::TextureAtlas::Handle player = atlas.getHandle("player");
+/// sf::Sprite sprite(*player.texture, player.textureRect);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
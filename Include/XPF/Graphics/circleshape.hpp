@@ -51,6 +51,30 @@ public:
     ////////////////////////////////////////////////////////////
     explicit CircleShape(float radius = 0, std::size_t pointCount = 30);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    CircleShape(const CircleShape& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CircleShape();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    CircleShape& operator =(const CircleShape& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the radius of the circle
     ///
@@ -106,13 +130,24 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const;
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the points of the circle at once
+    ///
+    /// \param points Array of getPointCount() points to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     ///< Radius of the circle
-    std::size_t m_pointCount; ///< Number of points composing the circle
+    float           m_radius;     ///< Radius of the circle
+    std::size_t     m_pointCount; ///< Number of points composing the circle
+    const Vector2f* m_unitPoints; ///< Points of the unit circle, shared by all the circles with the same point count
 };
 
 } // namespace sf
@@ -149,6 +184,10 @@ private:
 /// small numbers you can create any regular polygon shape:
 /// equilateral triangle, square, pentagon, hexagon, ...
 ///
+/// The points of a circle of radius 1 are computed once per
+/// point count and shared by all the circles which use it, so
+/// changing the radius of a circle is cheap.
+///
 /// \see sf::Shape, sf::RectangleShape, sf::ConvexShape
 ///
 ////////////////////////////////////////////////////////////
@@ -107,6 +107,16 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const;
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the points of the polygon at once
+    ///
+    /// \param points Array of getPointCount() points to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
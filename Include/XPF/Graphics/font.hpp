@@ -34,6 +34,7 @@
 #include <XPF/Graphics/Rect.hpp>
 #include <XPF/System/Vector2.hpp>
 #include <XPF/System/String.hpp>
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -43,6 +44,11 @@ namespace sf
 {
 class InputStream;
 
+namespace priv
+{
+    class GlyphRasterizer;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
 ///
@@ -175,6 +181,47 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded the first time they are
+    /// requested, which can cause hiccups when new characters
+    /// appear on screen. This function loads all the characters
+    /// of \a characters at once, typically right after the font
+    /// is loaded, so that later calls to getGlyph are simple
+    /// cache lookups.
+    ///
+    /// \param characters    Characters to load (duplicates are ignored)
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold versions or the regular ones?
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, unsigned int characterSize, bool bold = false) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request glyphs to be loaded in the background
+    ///
+    /// Unlike preloadGlyphs, this function returns immediately:
+    /// the glyphs are rasterized by worker threads, each one
+    /// using its own FreeType face, and are added to the font's
+    /// textures on the calling thread the next time a glyph
+    /// which is not loaded yet is requested. Glyphs requested
+    /// before their background rasterization is finished are
+    /// loaded synchronously, as usual.
+    ///
+    /// Background loading is only available for fonts loaded
+    /// from a file or from memory; for fonts loaded from a
+    /// stream, the glyphs are loaded immediately.
+    ///
+    /// \param characters    Characters to load
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold versions or the regular ones?
+    ///
+    /// \see preloadGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void requestGlyphs(const String& characters, unsigned int characterSize, bool bold = false) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -240,7 +287,12 @@ public:
     ///
     /// The contents of the returned texture changes as more glyphs
     /// are requested, thus it is not very relevant. It is mainly
-    /// used internally by sf::Text.
+    /// used internally by sf::Text. Glyphs loaded since the last
+    /// call are uploaded to the texture before it is returned.
+    ///
+    /// This function returns the first page of glyphs; when
+    /// a character size needs more than one texture, use the
+    /// overload that takes a page index (see Glyph::page).
     ///
     /// \param characterSize Reference character size
     ///
@@ -249,6 +301,34 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a page of the textures containing the loaded glyphs of a certain size
+    ///
+    /// When a page is full, new glyphs are stored in a new
+    /// page; the page that contains a glyph is given by its
+    /// Glyph::page member. If \a page is out of range, the
+    /// first page is returned.
+    ///
+    /// \param characterSize Reference character size
+    /// \param page          Index of the page
+    ///
+    /// \return Texture containing the glyphs of the requested size and page
+    ///
+    /// \see getPageCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int characterSize, unsigned int page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of texture pages used by a character size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Number of pages (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageCount(unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -274,31 +354,121 @@ private:
         unsigned int height; ///< Height of the row
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Open-addressing hash table mapping 64-bit keys to 32-bit values
+    ///
+    /// Used for the glyph and kerning caches, which are looked
+    /// up for every character of every text: one flat array
+    /// with linear probing is much faster than a tree of nodes.
+    ///
+    ////////////////////////////////////////////////////////////
+    class FlatTable
+    {
+    public:
+
+        FlatTable();
+
+        const Uint32* find(Uint64 key) const;
+        void insert(Uint64 key, Uint32 value);
+        void clear();
+
+    private:
+
+        struct Slot
+        {
+            Uint64 key;   ///< Key of the entry
+            Uint32 value; ///< Value of the entry
+            bool   used;  ///< Does the slot hold an entry?
+        };
+
+        void grow();
+
+        std::vector<Slot> m_slots; ///< Slots of the table (the size is always a power of two)
+        std::size_t       m_count; ///< Number of used slots
+    };
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint32, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    typedef std::multimap<unsigned int, std::size_t> RowIndex; ///< Open rows of a page, indexed by height
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a page of glyphs
+    /// \brief Structure defining a page (texture) of glyphs
     ///
     ////////////////////////////////////////////////////////////
     struct Page
     {
         Page();
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        Texture            texture;     ///< Texture containing the pixels of the glyphs
+        std::vector<Uint8> pixels;      ///< CPU copy of the texture, where new glyphs are staged before being uploaded
+        unsigned int       nextRow;     ///< Y position of the next new row in the texture
+        std::vector<Row>   rows;        ///< List containing the position of all the existing rows
+        RowIndex           openRows;    ///< Rows that still have room for more glyphs
+        unsigned int       dirtyTop;    ///< First row of pixels not uploaded to the texture yet
+        unsigned int       dirtyBottom; ///< Row after the last one not uploaded yet (equal to dirtyTop if the texture is up to date)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining the glyphs of a character size
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Atlas
+    {
+        Atlas();
+
+        Uint32           ascii[256]; ///< Indices + 1 of the regular (0-127) and bold (128-255) ASCII glyphs, 0 if not loaded yet
+        FlatTable        kerning;    ///< Kerning offsets (in 26.6 units) of the character pairs already used
+        std::deque<Page> pages;      ///< Pages storing the pixels of the glyphs
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyphs and pages of a character size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Atlas of the character size, created if necessary
+    ///
+    ////////////////////////////////////////////////////////////
+    Atlas& getAtlas(unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Free all the internal resources
     ///
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Look for a glyph in the cache
+    ///
+    /// \param codePoint     Unicode code point of the character
+    /// \param characterSize Reference character size
+    /// \param bold          Regular or bold version?
+    ///
+    /// \return Pointer to the glyph, or NULL if it is not loaded yet
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph* findGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a loaded glyph into the cache
+    ///
+    /// \param codePoint     Unicode code point of the character
+    /// \param characterSize Reference character size
+    /// \param bold          Regular or bold version?
+    /// \param glyph         Glyph to insert
+    ///
+    /// \return Reference to the cached glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& storeGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, const Glyph& glyph) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the glyphs rasterized in the background to the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    void collectGlyphs() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -311,17 +481,55 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of a rasterized glyph into a page
+    ///
+    /// \param glyph         Glyph whose texture rect and page are filled
+    /// \param characterSize Reference character size
+    /// \param pixels        RGBA pixels of the glyph's bitmap
+    /// \param width         Width of the bitmap
+    /// \param height        Height of the bitmap
+    ///
+    ////////////////////////////////////////////////////////////
+    void placeGlyph(Glyph& glyph, unsigned int characterSize, const Uint8* pixels, unsigned int width, unsigned int height) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
-    /// \param page   Page of glyphs to search in
+    /// \param atlas  Glyphs of the character size to search in
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
+    /// \param page   Receives the index of the page containing the rectangle
     ///
     /// \return Found rectangle within the texture
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
+    IntRect findGlyphRect(Atlas& atlas, unsigned int width, unsigned int height, unsigned int& page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Grow a page until it can hold a new row
+    ///
+    /// \param page      Page to grow
+    /// \param width     Width of the glyph that starts the row
+    /// \param rowHeight Height of the new row
+    ///
+    /// \return True if the row fits, false if the page can't grow anymore
+    ///
+    ////////////////////////////////////////////////////////////
+    bool makeRoom(Page& page, unsigned int width, unsigned int rowHeight) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the glyphs staged in a page to its texture
+    ///
+    /// New glyphs are only written to the CPU copy of their page;
+    /// this function uploads all the rows modified since the last
+    /// call with a single texture update. It is called whenever
+    /// the texture of a page is requested.
+    ///
+    /// \param page Page to upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadPage(Page& page) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
@@ -336,20 +544,29 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, Atlas> AtlasTable; ///< Table mapping a character size to its glyphs and pages
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    ///< Reference counter used by implicit sharing
-    Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                          m_library;       ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                          m_face;          ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                          m_streamRec;     ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    int*                           m_refCount;      ///< Reference counter used by implicit sharing
+    Info                           m_info;          ///< Information about the font
+    mutable AtlasTable             m_atlases;       ///< Table containing the glyphs and their pages by character size
+    mutable Atlas*                 m_lastAtlas;     ///< Atlas returned by the last call to getAtlas
+    mutable unsigned int           m_lastSize;      ///< Character size of m_lastAtlas
+    mutable std::deque<Glyph>      m_glyphs;        ///< Storage of all the loaded glyphs (a deque keeps returned references valid)
+    mutable FlatTable              m_glyphTable;    ///< Table mapping (code point, size, bold) keys to indices in m_glyphs
+    mutable std::vector<Uint8>     m_pixelBuffer;   ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    std::string                    m_filename;      ///< Path of the font file, if loaded from a file
+    const void*                    m_memoryData;    ///< Font file data, if loaded from memory
+    std::size_t                    m_memorySize;    ///< Size of the font file data, if loaded from memory
+    mutable priv::GlyphRasterizer* m_rasterizer;    ///< Worker threads loading requested glyphs in the background
+    mutable unsigned int           m_pendingGlyphs; ///< Number of glyphs requested and not collected yet
     #ifdef SFML_SYSTEM_ANDROID
-    void*                      m_stream; ///< Asset file streamer (if loaded from file)
+    void*                          m_stream;        ///< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -46,14 +46,15 @@ public:
     /// \brief Default constructor
     ///
     ////////////////////////////////////////////////////////////
-    Glyph() : advance(0) {}
+    Glyph() : advance(0), page(0) {}
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float     advance;     ///< Offset to move horizontally to the next character
-    FloatRect bounds;      ///< Bounding rectangle of the glyph, in coordinates relative to the baseline
-    IntRect   textureRect; ///< Texture coordinates of the glyph inside the font's texture
+    float        advance;     ///< Offset to move horizontally to the next character
+    FloatRect    bounds;      ///< Bounding rectangle of the glyph, in coordinates relative to the baseline
+    IntRect      textureRect; ///< Texture coordinates of the glyph inside the font's texture
+    unsigned int page;        ///< Index of the font's texture page that contains the glyph
 };
 
 } // namespace sf
@@ -70,7 +71,7 @@ public:
 ///
 /// The sf::Glyph structure provides the information needed
 /// to handle the glyph:
-/// \li its coordinates in the font's texture
+/// \li its coordinates in the font's texture, and the page of that texture
 /// \li its bounding rectangle
 /// \li the offset to apply to get the starting position of the next glyph
 ///
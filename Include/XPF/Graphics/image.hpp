@@ -258,6 +258,22 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used to process large images
+    ///
+    /// copy (with alpha blending), createMaskFromColor and the
+    /// flip functions split large images into bands of rows,
+    /// processed in parallel. Small images are always processed
+    /// by the calling thread. The default is 1 (no parallelism).
+    ///
+    /// This function can be called from any thread; operations
+    /// already running keep using the previous count.
+    ///
+    /// \param threadCount Maximum number of threads, including the calling one
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadCount(unsigned int threadCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -35,14 +35,22 @@
 #include <XPF/Graphics/Transform.hpp>
 #include <XPF/Graphics/BlendMode.hpp>
 #include <XPF/Graphics/RenderStates.hpp>
+#include <XPF/Graphics/RenderStatistics.hpp>
 #include <XPF/Graphics/PrimitiveType.hpp>
 #include <XPF/Graphics/Vertex.hpp>
 #include <XPF/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class VertexBuffer;
+
+namespace priv
+{
+    class ShaderPipeline;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -247,6 +255,186 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draws that share the
+    /// same texture, blend mode, shader and primitive type are not
+    /// sent to the graphics card immediately. Line strips are
+    /// converted to lines, triangle strips and fans (such as the
+    /// ones of sprites and shapes) to triangles. Their vertices are
+    /// pre-transformed and accumulated into a single vertex stream,
+    /// which is rendered with one draw call as soon as an incompatible
+    /// draw is issued, the view changes, the target is cleared,
+    /// flush() is called, or the frame is displayed.
+    ///
+    /// Since drawing is deferred, the textures and shaders used by
+    /// pending draws must stay alive and unchanged until the batch
+    /// is flushed. If you modify a texture or a shader parameter
+    /// between two draws, call flush() before doing so.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush, getBatchCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the pending batch, if any
+    ///
+    /// This function is called automatically whenever needed,
+    /// you only have to call it yourself before modifying a
+    /// texture or a shader that is used by pending draws, or
+    /// before issuing direct OpenGL calls.
+    ///
+    /// It does nothing if batching is disabled.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of batches rendered during the last frame
+    ///
+    /// This is the number of draw calls that were actually
+    /// issued by the batching system between the two last
+    /// calls to display(). Comparing it with the number of
+    /// objects you draw tells how effective batching is.
+    ///
+    /// \return Number of batches issued during the last frame
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBatchCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable view culling
+    ///
+    /// When culling is enabled, the drawables of SFML (sprites,
+    /// shapes, texts, vertex arrays...) compare their bounding
+    /// rectangle with the area covered by the current view, and
+    /// don't draw anything when they are entirely outside of it.
+    /// This saves all the work of drawing off-screen objects in
+    /// large scrolling worlds.
+    ///
+    /// Objects drawn with a custom shader whose vertex stage
+    /// moves them outside of their bounds may be wrongly culled.
+    ///
+    /// Culling is disabled by default.
+    ///
+    /// \param enabled True to enable culling, false to disable it
+    ///
+    /// \see isCullingEnabled, isCulled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCullingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether view culling is enabled
+    ///
+    /// \return True if culling is enabled, false otherwise
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCullingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a rectangle is culled by the current view
+    ///
+    /// This function can be used by custom drawables to skip
+    /// their geometry in the same way as the SFML drawables.
+    /// It always returns false when culling is disabled.
+    ///
+    /// \param bounds    Bounding rectangle, in local coordinates
+    /// \param transform Transform from local to world coordinates
+    ///
+    /// \return True if the rectangle is entirely outside of the view
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCulled(const FloatRect& bounds, const Transform& transform = Transform::Identity) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last frame
+    ///
+    /// The counters are accumulated between two calls to
+    /// display(), and the returned statistics describe the
+    /// last displayed frame; see sf::RenderStatistics.
+    ///
+    /// \return Statistics of the last frame
+    ///
+    /// \see setGpuTimingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStatistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the measure of the GPU time of frames
+    ///
+    /// When enabled, and if the driver supports timer queries,
+    /// the time spent by the graphics card to render each frame
+    /// is measured and reported in the statistics.
+    ///
+    /// A timer query stays active during the whole frame, so
+    /// you must not use your own GL_TIME_ELAPSED queries on
+    /// this target while timing is enabled.
+    ///
+    /// GPU timing is disabled by default.
+    ///
+    /// \param enabled True to enable GPU timing, false to disable it
+    ///
+    /// \see isGpuTimingEnabled, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGpuTimingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the GPU time of frames is measured
+    ///
+    /// \return True if GPU timing is enabled, false otherwise
+    ///
+    /// \see setGpuTimingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isGpuTimingEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -340,6 +528,16 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Performs the common finalization step of a frame
+    ///
+    /// The derived classes must call this function right before
+    /// presenting the contents of the target. It renders the
+    /// pending batch and updates the per-frame counters.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -348,6 +546,24 @@ private:
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the area covered by the current view, used for culling
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateViewBounds();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the timer query of the current frame, if needed
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginGpuTimer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the timer query of the current frame and read the previous one
+    ///
+    ////////////////////////////////////////////////////////////
+    void endGpuTimer();
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
@@ -380,6 +596,33 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup environment for drawing
+    ///
+    /// \param useVertexCache Are we going to use the vertex cache?
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(bool useVertexCache, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to use when drawing
+    /// \param vertexCount Number of vertices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clean up environment after drawing
+    ///
+    /// \param states Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupDraw(const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the target for rendering
     ///
@@ -408,14 +651,36 @@ private:
         Uint64    lastTextureId;  ///< Cached texture
         bool      useVertexCache; ///< Did we previously use the vertex cache?
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+
+        bool                batching;         ///< Is automatic batching enabled?
+        std::vector<Vertex> batchVertices;    ///< Pre-transformed vertices of the pending batch
+        PrimitiveType       batchType;        ///< Primitive type of the pending batch
+        BlendMode           batchBlendMode;   ///< Blending mode of the pending batch
+        const Texture*      batchTexture;     ///< Texture of the pending batch
+        Uint64              batchTextureId;   ///< Unique identifier of the texture of the pending batch
+        const Shader*       batchShader;      ///< Shader of the pending batch
+        unsigned int        batchCount;       ///< Number of batches issued during the current frame
+        unsigned int        lastBatchCount;   ///< Number of batches issued during the last frame
+
+        bool                culling;          ///< Is view culling enabled?
+        FloatRect           viewBounds;       ///< Area covered by the current view, in world coordinates
+
+        RenderStatistics    statistics;         ///< Statistics of the current frame
+        RenderStatistics    lastStatistics;     ///< Statistics of the last frame
+        bool                gpuTiming;          ///< Is GPU timing enabled?
+        unsigned int        gpuQueries[2];      ///< Timer queries, used alternately by consecutive frames
+        unsigned int        gpuQuery;           ///< Index of the timer query of the current frame
+        bool                gpuQueryActive;     ///< Is the timer query of the current frame started?
+        bool                gpuQueryPending[2]; ///< Has each timer query a result to read?
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                  m_defaultView; ///< Default view
+    View                  m_view;        ///< Current view
+    StatesCache           m_cache;       ///< Render states cache
+    priv::ShaderPipeline* m_pipeline;    ///< Programmable pipeline used by core profile contexts (null otherwise)
 };
 
 } // namespace sf
@@ -446,6 +711,19 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// When the context of the target is a core profile
+/// (ContextSettings::Core), the fixed-function pipeline is
+/// unavailable and the target renders through a built-in
+/// shader instead. Custom shaders used in this mode can read
+/// the same inputs as the built-in one: the sf_position,
+/// sf_color and sf_texCoords attributes, and the sf_projection,
+/// sf_modelView and sf_textureMatrix uniforms (the texture
+/// matrix is not applied to the other textures of the shader).
+/// Creating them still requires sf::Shader::isAvailable(),
+/// which some drivers don't report in core profile contexts.
+/// pushGLStates and popGLStates don't save anything in this
+/// mode.
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #include <XPF/Graphics/Export.hpp>
 #include <XPF/Graphics/RenderTarget.hpp>
 #include <XPF/Graphics/Image.hpp>
+#include <XPF/Graphics/ImageReadback.hpp>
 #include <XPF/Window/Window.hpp>
 #include <string>
 
@@ -128,6 +129,22 @@ public:
     ////////////////////////////////////////////////////////////
     Image capture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the current contents of the window to an image in the background
+    ///
+    /// Unlike capture, this function doesn't wait for the
+    /// graphics card: the image is retrieved later from
+    /// \a readback, typically a frame or two after the call.
+    ///
+    /// \param readback Readback receiving the pixels (a pending copy in it is dropped)
+    ///
+    /// \return True if the copy was started
+    ///
+    /// \see capture, ImageReadback
+    ///
+    ////////////////////////////////////////////////////////////
+    bool captureAsync(ImageReadback& readback) const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -149,6 +166,16 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window contents are displayed
+    ///
+    /// This function is called so that derived classes can
+    /// finish their pending rendering before the back buffer
+    /// is presented on screen.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
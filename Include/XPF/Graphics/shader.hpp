@@ -36,6 +36,7 @@
 #include <XPF/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -45,6 +46,11 @@ class InputStream;
 class Texture;
 class Transform;
 
+namespace priv
+{
+    class ShaderPipeline;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex and fragment)
 ///
@@ -80,6 +86,56 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pre-resolved reference to a uniform variable
+    ///
+    /// Handles are returned by getUniformHandle, and make
+    /// setting a uniform skip the lookup of its name. They stay
+    /// valid until the shader is loaded again.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API UniformHandle
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an invalid handle.
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a uniform of the shader
+        ///
+        /// \return True if the handle is valid
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const;
+
+    private:
+
+        friend class Shader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle of a uniform
+        ///
+        /// \param location   Location of the uniform in the program
+        /// \param slot       Index of the value stored for the uniform
+        /// \param generation Generation of the program the uniform belongs to
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle(int location, std::size_t slot, Uint64 generation);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        int         m_location;   ///< Location of the uniform in the program (-1 if invalid)
+        std::size_t m_slot;       ///< Index of the value stored for the uniform
+        Uint64      m_generation; ///< Generation of the program the uniform belongs to
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -478,6 +534,184 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a uniform variable
+    ///
+    /// Setting a uniform through its handle avoids looking up
+    /// its name every time. If the uniform doesn't exist in the
+    /// shader, an invalid handle is returned (and setting a
+    /// value through it does nothing).
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param x       Value of the scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the vec2
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the vec3
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the vec4
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param x       Value of the scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the ivec2
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the ivec3
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the ivec4
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param x       Value of the scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the bvec2
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the bvec3
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param vector  Value of the bvec4
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param matrix  Value of the mat3
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix, through its handle
+    ///
+    /// \param uniform Handle of the uniform variable
+    /// \param matrix  Value of the mat4
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& uniform, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable deferred uniform updates
+    ///
+    /// By default, every setUniform call sends the value to the
+    /// program immediately, which requires switching to the
+    /// program and back. In deferred mode, values are stored
+    /// and only the ones that changed are sent when the shader
+    /// is bound for drawing, which is much cheaper when many
+    /// uniforms change between two draws.
+    ///
+    /// Disabling deferred mode sends the pending values.
+    ///
+    /// \param deferred True to defer uniform updates, false to apply them immediately
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDeferredUniforms(bool deferred);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify the contents of a uniform block
+    ///
+    /// The data is copied to a uniform buffer owned by the shader,
+    /// and the buffer is bound to the block whenever the shader is
+    /// bound. Its layout must match the declaration of the block
+    /// (use the std140 layout to make it predictable).
+    ///
+    /// Uniform blocks require OpenGL 3.1 or the
+    /// ARB_uniform_buffer_object extension.
+    ///
+    /// \param name Name of the uniform block in GLSL
+    /// \param data Contents of the block
+    /// \param size Size of the contents, in bytes
+    ///
+    /// \return True if the block was updated, false if it doesn't exist or uniform blocks are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setUniformBlock(const std::string& name, const void* data, std::size_t size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -605,8 +839,31 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the directory of the program binary cache
+    ///
+    /// When a cache directory is set and the driver supports
+    /// program binaries, every successfully linked shader is
+    /// saved to this directory, and later compilations of the
+    /// same sources load the binary instead of compiling again.
+    /// Binaries are keyed by the shader sources and by the
+    /// vendor, renderer and version of the driver, so they are
+    /// never reused across driver updates. If the driver rejects
+    /// a cached binary, the shader is compiled from its sources
+    /// and the cache entry is replaced.
+    ///
+    /// The directory must already exist. The cache is disabled
+    /// by default; pass an empty string to disable it again.
+    ///
+    /// \param directory Path of the cache directory
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
 private:
 
+    friend class priv::ShaderPipeline;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -640,6 +897,87 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of uniform values
+    ///
+    ////////////////////////////////////////////////////////////
+    enum UniformType
+    {
+        Float1,  ///< float, vec2, vec3 or vec4 (array)
+        Float2,
+        Float3,
+        Float4,
+        Int1,    ///< int, ivec2, ivec3 or ivec4 (also used for booleans)
+        Int2,
+        Int3,
+        Int4,
+        Matrix3, ///< mat3 (array)
+        Matrix4  ///< mat4 (array)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Value of a uniform, stored until it is sent to the program
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformValue
+    {
+        UniformValue(int location);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Send the value to the current program
+        ///
+        ////////////////////////////////////////////////////////////
+        void apply() const;
+
+        int                location; ///< Location of the uniform
+        UniformType        type;     ///< Type of the value
+        std::size_t        count;    ///< Number of array elements
+        std::vector<float> floats;   ///< Components of float values
+        int                ints[4];  ///< Components of int values
+        bool               dirty;    ///< Must the value be sent when the shader is bound?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Uniform block and the buffer holding its contents
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformBlock
+    {
+        std::string  name;   ///< Name of the block
+        unsigned int buffer; ///< Uniform buffer object, bound to the binding point of the same index
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the value of a uniform, and send it now or on next bind
+    ///
+    /// \param uniform Handle of the uniform
+    /// \param type    Type of the value
+    /// \param floats  Float components (NULL for int values)
+    /// \param ints    Int components (NULL for float values)
+    /// \param size    Total number of components
+    /// \param count   Number of array elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformValue(const UniformHandle& uniform, UniformType type, const float* floats, const int* ints, std::size_t size, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the deferred uniform values that changed to the current program
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the uniform buffers to their binding points
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindUniformBlocks() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the uniform values, blocks and their buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearUniforms();
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -653,15 +991,20 @@ private:
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::map<int, const Texture*> TextureTable;
-    typedef std::map<std::string, int> UniformTable;
+    typedef std::map<std::string, UniformHandle> UniformTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       ///< Parameters location cache
+    unsigned int                      m_shaderProgram;    ///< OpenGL identifier for the program
+    int                               m_currentTexture;   ///< Location of the current texture in the shader
+    TextureTable                      m_textures;         ///< Texture variables in the shader, mapped to their location
+    UniformTable                      m_uniforms;         ///< Parameters handle cache
+    mutable std::vector<UniformValue> m_values;           ///< Stored uniform values, indexed by handle slot
+    mutable std::vector<std::size_t>  m_dirtyUniforms;    ///< Slots of the values to send on next bind
+    bool                              m_deferredUniforms; ///< Are uniform updates deferred until bind?
+    std::vector<UniformBlock>         m_blocks;           ///< Uniform blocks used by the shader
+    Uint64                            m_generation;       ///< Unique stamp of the current program, shared by its uniform handles
 };
 
 } // namespace sf
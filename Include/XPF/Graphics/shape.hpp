@@ -33,6 +33,7 @@
 #include <XPF/Graphics/Transformable.hpp>
 #include <XPF/Graphics/VertexArray.hpp>
 #include <XPF/System/Vector2.hpp>
+#include <vector>
 
 
 namespace sf
@@ -265,6 +266,19 @@ protected:
     ////////////////////////////////////////////////////////////
     void update();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the points of the shape at once
+    ///
+    /// This function is called by update() to retrieve the
+    /// geometry of the shape. The default implementation calls
+    /// getPoint for each point; derived classes which can
+    /// compute their points in a single pass should override it.
+    ///
+    /// \param points Array of getPointCount() points to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -294,6 +308,12 @@ private:
     ////////////////////////////////////////////////////////////
     void updateOutline();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the outer outline vertices from the cached normals
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutlineThickness();
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' color
     ///
@@ -305,15 +325,17 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*        m_texture;          ///< Texture of the shape
+    IntRect               m_textureRect;      ///< Rectangle defining the area of the source texture to display
+    Color                 m_fillColor;        ///< Fill color
+    Color                 m_outlineColor;     ///< Outline color
+    float                 m_outlineThickness; ///< Thickness of the shape's outline
+    VertexArray           m_vertices;         ///< Vertex array containing the fill geometry
+    VertexArray           m_outlineVertices;  ///< Vertex array containing the outline geometry
+    FloatRect             m_insideBounds;     ///< Bounding rectangle of the inside (fill)
+    FloatRect             m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    std::vector<Vector2f> m_positions;        ///< Points of the shape, filled by getPoints
+    std::vector<Vector2f> m_outlineNormals;   ///< Extrusion direction of each outline point
 };
 
 } // namespace sf
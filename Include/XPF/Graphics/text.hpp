@@ -101,6 +101,10 @@ public:
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// When the new string starts with the current one (text
+    /// appended to a log, for example), only the new characters
+    /// are laid out.
+    ///
     /// \param string New string
     ///
     /// \see getString
@@ -293,7 +297,11 @@ private:
     /// \brief Make sure the text's geometry is updated
     ///
     /// All the attributes related to rendering are cached, such
-    /// that the geometry is only updated when necessary.
+    /// that the geometry is only updated when necessary: the
+    /// characters appended to the string since the last update
+    /// are laid out after the existing ones, and the underline
+    /// and strike-through lines are rebuilt without touching
+    /// the characters' quads.
     ///
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
@@ -301,14 +309,22 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;             ///< String to display
-    const Font*         m_font;               ///< Font used to display the string
-    unsigned int        m_characterSize;      ///< Base size of characters, in pixels
-    Uint32              m_style;              ///< Text style (see Style enum)
-    Color               m_color;              ///< Text color
-    mutable VertexArray m_vertices;           ///< Vertex array containing the text's geometry
-    mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    String                           m_string;                ///< String to display
+    const Font*                      m_font;                  ///< Font used to display the string
+    unsigned int                     m_characterSize;         ///< Base size of characters, in pixels
+    Uint32                           m_style;                 ///< Text style (see Style enum)
+    Color                            m_color;                 ///< Text color
+    mutable std::vector<VertexArray> m_vertices;              ///< Vertex arrays containing the characters' quads, one per font page
+    mutable VertexArray              m_decorations;           ///< Vertex array containing the underline and strike-through lines
+    mutable FloatRect                m_bounds;                ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool                     m_geometryNeedUpdate;    ///< Does the whole geometry need to be recomputed?
+    mutable bool                     m_decorationsNeedUpdate; ///< Do the underline and strike-through lines need to be recomputed?
+    mutable std::size_t              m_laidOutCount;          ///< Number of characters of the string already laid out
+    mutable Vector2f                 m_pen;                   ///< Position of the next character to lay out
+    mutable Uint32                   m_previousChar;          ///< Last character laid out, for kerning
+    mutable Vector2f                 m_boundsMin;             ///< Minimum coordinates of the characters laid out so far
+    mutable Vector2f                 m_boundsMax;             ///< Maximum coordinates of the characters laid out so far
+    mutable std::vector<Vector2f>    m_lineEnds;              ///< Pen position at the end of each finished line
 };
 
 } // namespace sf
@@ -36,10 +36,16 @@
 namespace sf
 {
 class Window;
+class ImageReadback;
 class RenderTarget;
 class RenderTexture;
 class InputStream;
 
+namespace priv
+{
+    class ShaderPipeline;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
 ///
@@ -236,6 +242,24 @@ public:
     ////////////////////////////////////////////////////////////
     Image copyToImage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the texture pixels to an image in the background
+    ///
+    /// Unlike copyToImage, this function doesn't wait for the
+    /// graphics card: the pixels are transferred while the
+    /// rendering continues, and the image is retrieved later
+    /// from \a readback. If asynchronous readbacks are not
+    /// supported, the copy is performed immediately.
+    ///
+    /// \param readback Readback receiving the pixels (a pending copy in it is dropped)
+    ///
+    /// \return True if the copy was started
+    ///
+    /// \see copyToImage, ImageReadback
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyToImageAsync(ImageReadback& readback) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the whole texture from an array of pixels
     ///
@@ -481,6 +505,8 @@ private:
 
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class StreamingTexture;
+    friend class priv::ShaderPipeline;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -497,6 +523,15 @@ private:
     ////////////////////////////////////////////////////////////
     static unsigned int getValidSize(unsigned int size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole texture from the bound pixel unpack buffer
+    ///
+    /// The buffer must contain 32-bits RGBA pixels, and have the
+    /// size of the texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateFromPixelBuffer();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
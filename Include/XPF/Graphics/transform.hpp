@@ -31,10 +31,13 @@
 #include <XPF/Graphics/Export.hpp>
 #include <XPF/Graphics/Rect.hpp>
 #include <XPF/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
 {
+class Vertex;
+
 ////////////////////////////////////////////////////////////
 /// \brief Define a 3x3 transform matrix
 ///
@@ -134,6 +137,33 @@ public:
     ////////////////////////////////////////////////////////////
     FloatRect transformRect(const FloatRect& rectangle) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// The result is the same as calling transformPoint on each
+    /// point, but SIMD instructions are used when the CPU
+    /// supports them.
+    ///
+    /// \param points Points to transform
+    /// \param result Array receiving the transformed points (can be \a points itself)
+    /// \param count  Number of points
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform the positions of an array of vertices
+    ///
+    /// The positions are transformed like with transformPoints;
+    /// colors and texture coordinates are copied unchanged.
+    ///
+    /// \param vertices Vertices to transform
+    /// \param result   Array receiving the transformed vertices (can be \a vertices itself)
+    /// \param count    Number of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformVertices(const Vertex* vertices, Vertex* result, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Combine the current transform with another one
     ///
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEPACER_HPP
+#define SFML_FRAMEPACER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/System/Export.hpp>
+#include <XPF/System/Time.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Utility class that paces frames to a fixed frame time
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FramePacer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called when a frame misses its deadline
+    ///
+    /// \param frameTime Duration of the late frame
+    /// \param lateness  Time elapsed between the deadline and the end of the frame
+    /// \param userData  User data passed to setMissedDeadlineCallback
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*MissedDeadlineCallback)(Time frameTime, Time lateness, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The pacer is disabled (zero frame time) and its
+    /// histogram covers 0 to 50 ms with 0.25 ms buckets.
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the target duration of a frame
+    ///
+    /// The schedule restarts from the current time.
+    ///
+    /// \param frameTime Target frame time (Time::Zero to disable pacing)
+    ///
+    /// \see getFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameTime(Time frameTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the target duration of a frame
+    ///
+    /// \return Target frame time
+    ///
+    /// \see setFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the time spent spinning before a deadline
+    ///
+    /// The pacer sleeps until \a threshold before the deadline,
+    /// then spins on the clock until the deadline is reached.
+    /// A larger threshold makes frame times more regular at
+    /// the cost of CPU time; Time::Zero only sleeps.
+    /// The default threshold is 2 ms.
+    ///
+    /// \param threshold Duration of the spin phase
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSpinThreshold(Time threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the function to call when a frame misses its deadline
+    ///
+    /// The callback is called from wait(), in the thread that
+    /// calls it.
+    ///
+    /// \param callback Function to call, or NULL to remove it
+    /// \param userData User data to pass to the callback
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMissedDeadlineCallback(MissedDeadlineCallback callback, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the deadline of the current frame
+    ///
+    /// This function must be called once per frame. It
+    /// records the duration of the frame which just ended,
+    /// and returns at the deadline of the frame, or
+    /// immediately if the deadline was missed. The deadlines
+    /// are absolute, so that the overshoot of a frame doesn't
+    /// delay the next ones; when a frame is late by more than
+    /// a frame time, the schedule restarts from now instead
+    /// of rendering a burst of frames to catch up.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the schedule from the current time
+    ///
+    /// Call this after a pause, so that the next frame is
+    /// not reported as late.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the range of the frame time histogram
+    ///
+    /// Frame times longer than the range are counted in the
+    /// last bucket. This clears the statistics.
+    ///
+    /// \param resolution  Width of a bucket
+    /// \param bucketCount Number of buckets
+    ///
+    ////////////////////////////////////////////////////////////
+    void setHistogramRange(Time resolution, std::size_t bucketCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the width of a bucket of the histogram
+    ///
+    /// \return Resolution of the histogram
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getHistogramResolution() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frame time histogram
+    ///
+    /// Bucket i counts the frames which lasted between
+    /// i * resolution and (i + 1) * resolution.
+    ///
+    /// \return Number of frames in each bucket
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Uint64>& getHistogram() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a percentile of the recorded frame times
+    ///
+    /// The result is rounded up to the resolution of the histogram.
+    ///
+    /// \param percentile Percentile to compute, in range [0, 100]
+    ///
+    /// \return Frame time below which \a percentile percent of the frames are
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTimePercentile(float percentile) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded frames
+    ///
+    /// \return Number of frames since the statistics were cleared
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames which missed their deadline
+    ///
+    /// \return Number of late frames since the statistics were cleared
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMissedDeadlineCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the histogram and the counters
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearStatistics();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Time                   m_frameTime;       ///< Target frame time
+    Time                   m_spinThreshold;   ///< Time spent spinning before a deadline
+    Time                   m_deadline;        ///< Deadline of the current frame
+    Time                   m_frameStart;      ///< Time at which the current frame started
+    MissedDeadlineCallback m_callback;        ///< Function to call on missed deadlines
+    void*                  m_userData;        ///< User data passed to the callback
+    Time                   m_resolution;      ///< Width of a bucket of the histogram
+    std::vector<Uint64>    m_histogram;       ///< Number of frames per duration bucket
+    Uint64                 m_frameCount;      ///< Number of recorded frames
+    Uint64                 m_missedDeadlines; ///< Number of frames which missed their deadline
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPACER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FramePacer
+/// \ingroup system
+///
+/// sf::FramePacer keeps a loop running at a fixed frame time
+/// with a better precision than sf::sleep: it sleeps until
+/// shortly before the deadline of the frame (with an absolute
+/// sleep where the system supports it), then spins on the
+/// clock until the deadline. Deadlines are computed from the
+/// previous ones rather than from the end of the previous
+/// frame, so the overshoot of the sleeps doesn't accumulate.
+///
+/// It also records a histogram of the frame times, and can
+/// notify the application when a frame misses its deadline.
+///
+/// sf::Window uses a sf::FramePacer when a framerate limit is
+/// set (see sf::Window::setFramerateLimit and
+/// sf::Window::getFramePacer), but it can be used for any loop.
+///
+/// Usage example:
+/// \code
+/// void onMissedDeadline(sf::Time frameTime, sf::Time lateness, void*)
+/// {
+///     std::cout << "Frame late by " << lateness.asMicroseconds() << " us" << std::endl;
+/// }
+///
+/// sf::FramePacer pacer;
+/// pacer.setFrameTime(sf::seconds(1.f / 144));
+/// pacer.setMissedDeadlineCallback(&onMissedDeadline);
+///
+/// while (running)
+/// {
+///     update();
+///     pacer.wait();
+/// }
+///
+/// std::cout << "99th percentile: " << pacer.getFrameTimePercentile(99).asMilliseconds() << " ms" << std::endl;
+/// \endcode
+///
+/// \see sf::Clock, sf::sleep
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONTEXTPOOL_HPP
+#define SFML_CONTEXTPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Window/Export.hpp>
+#include <XPF/Window/GlResource.hpp>
+#include <XPF/System/Mutex.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class GlContext;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of shared OpenGL contexts for loader threads
+///
+////////////////////////////////////////////////////////////
+class SFML_WINDOW_API ContextPool : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lease of a context of the pool
+    ///
+    /// The constructor takes a context from the pool and
+    /// activates it on the current thread, the destructor
+    /// gives it back.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_WINDOW_API Lease : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Lease a context from a pool
+        ///
+        /// If all the contexts of the pool are leased, this
+        /// constructor blocks until one is given back.
+        ///
+        /// \param pool Pool to take the context from
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Lease(ContextPool& pool);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Give the context back to its pool
+        ///
+        /// A fence is inserted after the commands issued on the
+        /// context, and the context is deactivated without
+        /// activating another one on the current thread.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Lease();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        ContextPool&     m_pool;    ///< Pool that owns the context
+        priv::GlContext* m_context; ///< Leased context, NULL if the pool is empty
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the contexts of the pool
+    ///
+    /// The contexts are shared with all the other contexts,
+    /// so the resources loaded with a lease can be used
+    /// everywhere once synchronize() was called.
+    ///
+    /// \param count Number of contexts to create
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ContextPool(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the leases must have been given back.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ContextPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of contexts in the pool
+    ///
+    /// \return Number of contexts, leased or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getContextCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the active context wait for the finished leases
+    ///
+    /// The active context of the calling thread waits on the
+    /// GPU for the fences of the leases given back since the
+    /// last call, so that the resources they loaded are
+    /// complete before it uses them. The calling thread
+    /// itself doesn't wait. Call this function regularly,
+    /// typically once per frame before drawing.
+    ///
+    /// If fences are not supported (OpenGL < 3.2), leases
+    /// call glFinish when they are given back instead, and
+    /// this function does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    void synchronize();
+
+private:
+
+    friend class Lease;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a context from the pool and activate it
+    ///
+    /// If all the contexts are leased, this function sleeps
+    /// until one is given back.
+    ///
+    /// \return Context, NULL if the pool has no context
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::GlContext* acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a fence, deactivate a context and give it back
+    ///
+    /// A thread waiting in acquire() is woken up.
+    ///
+    /// \param context Context to give back
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(priv::GlContext* context);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<priv::GlContext*> m_contexts;  ///< All the contexts of the pool
+    std::vector<priv::GlContext*> m_available; ///< Contexts that are not leased
+    std::vector<void*>            m_fences;    ///< Fences of the given back leases, not waited for yet
+    mutable Mutex                 m_mutex;     ///< Mutex protecting the available contexts and the fences
+    std::condition_variable_any   m_released;  ///< Condition signaled when a context is given back
+};
+
+} // namespace sf
+
+
+#endif // SFML_CONTEXTPOOL_HPP
+
+////////////////////////////////////////////////////////////
+/// \class sf::ContextPool
+/// \ingroup window
+///
+/// Loading textures or fonts on worker threads needs an
+/// active context in each of them. Without one, a context
+/// is created on demand for every thread, behind a global
+/// lock. sf::ContextPool creates a fixed number of shared
+/// contexts up front instead, and loader threads lease them
+/// with sf::ContextPool::Lease for the duration of a job.
+///
+/// When a lease ends, a fence is inserted after the commands
+/// issued on its context. The thread that draws calls
+/// synchronize() to make its own context wait for these
+/// fences on the GPU, so the loaded resources can be drawn
+/// safely without calling glFinish anywhere.
+///
+/// Usage example:
+/// \code
+/// sf::ContextPool pool(2);
+///
+/// // On the loader threads
+/// void load(sf::ContextPool* pool)
+/// {
+///     sf::ContextPool::Lease lease(*pool);
+///     texture.loadFromFile("background.png");
+/// }
+///
+/// // On the main thread, once per frame
+/// pool.synchronize();
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::Context
+///
+////////////////////////////////////////////////////////////
@@ -161,6 +161,9 @@ public:
     /// call it if you have no window yet (or no window at all):
     /// in this case the joystick states are not updated automatically.
     ///
+    /// On Linux, joysticks are updated by a background thread as
+    /// soon as input arrives, and this function does nothing.
+    ///
     ////////////////////////////////////////////////////////////
     static void update();
 };
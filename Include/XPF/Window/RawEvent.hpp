@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RAWEVENT_HPP
+#define SFML_RAWEVENT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Config.hpp>
+#include <XPF/Window/Keyboard.hpp>
+#include <XPF/Window/Mouse.hpp>
+#include <XPF/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Defines a raw input event and its parameters
+///
+////////////////////////////////////////////////////////////
+class RawEvent
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keyboard event parameters (KeyPressed, KeyReleased)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct KeyEvent
+    {
+        Keyboard::Key code; ///< Code of the key, regardless of the keyboard modifiers
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mouse move event parameters (MouseMoved)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MouseMoveEvent
+    {
+        float deltaX; ///< Horizontal motion reported by the device, without acceleration
+        float deltaY; ///< Vertical motion reported by the device, without acceleration
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mouse buttons events parameters
+    ///        (MouseButtonPressed, MouseButtonReleased)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MouseButtonEvent
+    {
+        Mouse::Button button; ///< Code of the button
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mouse wheel events parameters (MouseWheelScrolled)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MouseWheelScrollEvent
+    {
+        Mouse::Wheel wheel; ///< Which wheel (for mice with multiple ones)
+        float        delta; ///< Wheel offset (positive is up/left, negative is down/right)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the different types of raw events
+    ///
+    ////////////////////////////////////////////////////////////
+    enum EventType
+    {
+        KeyPressed,          ///< A key was pressed (data in event.key)
+        KeyReleased,         ///< A key was released (data in event.key)
+        MouseMoved,          ///< The mouse moved (data in event.mouseMove)
+        MouseButtonPressed,  ///< A mouse button was pressed (data in event.mouseButton)
+        MouseButtonReleased, ///< A mouse button was released (data in event.mouseButton)
+        MouseWheelScrolled,  ///< The mouse wheel was scrolled (data in event.mouseWheelScroll)
+
+        Count                ///< Keep last -- the total number of raw event types
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EventType type;      ///< Type of the event
+    Time      timestamp; ///< Time at which the event happened, see sf::Window::getRawInputTime
+
+    union
+    {
+        KeyEvent              key;              ///< Key event parameters (RawEvent::KeyPressed, RawEvent::KeyReleased)
+        MouseMoveEvent        mouseMove;        ///< Mouse move event parameters (RawEvent::MouseMoved)
+        MouseButtonEvent      mouseButton;      ///< Mouse button event parameters (RawEvent::MouseButtonPressed, RawEvent::MouseButtonReleased)
+        MouseWheelScrollEvent mouseWheelScroll; ///< Mouse wheel event parameters (RawEvent::MouseWheelScrolled)
+    };
+};
+
+} // namespace sf
+
+
+#endif // SFML_RAWEVENT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RawEvent
+/// \ingroup window
+///
+/// sf::RawEvent holds an input event as reported by the device,
+/// before the system turns it into a regular sf::Event. Mouse
+/// motion is given as the relative deltas measured by the mouse,
+/// unaccelerated and not coalesced, which makes raw events suited
+/// to high resolution mice and to input latency measurements.
+///
+/// Raw events are only recorded after raw input was enabled with
+/// sf::Window::setRawInputEnabled, and are retrieved in bulk with
+/// sf::Window::pollRawEvents. Each one is stamped with the time at
+/// which it happened, when the system reports it (the X server
+/// does, with millisecond precision), otherwise with the time at
+/// which the window received it.
+///
+/// As with sf::Event, only the member of the union matching the
+/// type of the event is filled.
+///
+/// Usage example:
+/// \code
+/// sf::RawEvent events[256];
+/// std::size_t count = window.pollRawEvents(events, 256);
+/// for (std::size_t i = 0; i < count; ++i)
+/// {
+///     if (events[i].type == sf::RawEvent::MouseMoved)
+///         camera.rotate(events[i].mouseMove.deltaX, events[i].mouseMove.deltaY);
+///
+///     sf::Time latency = window.getRawInputTime() - events[i].timestamp;
+/// }
+/// \endcode
+///
+/// \see sf::Window::setRawInputEnabled, sf::Event
+///
+////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include <XPF/Window/WindowStyle.hpp>
 #include <XPF/Window/GlResource.hpp>
 #include <XPF/System/Clock.hpp>
+#include <XPF/System/FramePacer.hpp>
 #include <XPF/System/Vector2.hpp>
 #include <XPF/System/NonCopyable.hpp>
 #include <XPF/System/String.hpp>
@@ -49,6 +50,7 @@ namespace priv
 }
 
 class Event;
+class RawEvent;
 
 ////////////////////////////////////////////////////////////
 /// \brief Window that serves as a target for OpenGL rendering
@@ -239,6 +241,100 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an event during a limited time and return it
+    ///
+    /// This function is blocking like waitEvent, but it gives up
+    /// and returns false once \a timeout has elapsed without any
+    /// event. A zero (or negative) timeout makes it equivalent to
+    /// pollEvent.
+    /// \code
+    /// sf::Event event;
+    /// while (window.waitEvent(event, sf::milliseconds(100)))
+    /// {
+    ///    // process event...
+    /// }
+    /// // no event during the last 100 ms, do some idle work...
+    /// \endcode
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event
+    ///
+    /// \return True if an event was returned, false if the timeout elapsed or an error occurred
+    ///
+    /// \see pollEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the recording of raw input events
+    ///
+    /// Raw events are kept in a ring buffer of \a capacity events
+    /// until they are retrieved with pollRawEvents; when it is
+    /// full, the oldest events are dropped. They are recorded in
+    /// addition to the regular events, and they are reported
+    /// even when the window doesn't have the focus.
+    ///
+    /// Raw input is currently only supported on Linux (XInput 2),
+    /// this function returns false on other systems.
+    /// Changing the capacity discards the events in the buffer.
+    ///
+    /// \param enabled  True to enable, false to disable
+    /// \param capacity Maximum number of events kept in the buffer
+    ///
+    /// \return True if the operation succeeded
+    ///
+    /// \see pollRawEvents
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setRawInputEnabled(bool enabled, std::size_t capacity = 1024);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the raw input events received so far
+    ///
+    /// The oldest events are copied to \a events, and removed
+    /// from the buffer. Call this function once per frame with
+    /// a large enough array to drain the buffer in one go.
+    /// \code
+    /// sf::RawEvent events[256];
+    /// std::size_t count;
+    /// while ((count = window.pollRawEvents(events, 256)) > 0)
+    /// {
+    ///    // process events...
+    /// }
+    /// \endcode
+    ///
+    /// \param events   Array receiving the events
+    /// \param maxCount Size of the array
+    ///
+    /// \return Number of events written to \a events
+    ///
+    /// \see setRawInputEnabled, getRawInputTime
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pollRawEvents(RawEvent* events, std::size_t maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of raw events dropped because the buffer was full
+    ///
+    /// \return Number of raw events lost since raw input was enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedRawEventCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time on the clock that stamps raw events
+    ///
+    /// Raw event timestamps are measured from the moment raw
+    /// input was enabled. Subtracting the timestamp of an event
+    /// from this time gives how long ago it happened.
+    ///
+    /// \return Time elapsed since raw input was enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRawInputTime() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -370,17 +466,30 @@ public:
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// The delay is handled by the frame pacer of the window,
+    /// which sleeps then spins until an absolute deadline, so
+    /// the limit is matched precisely at the cost of a little
+    /// CPU time (see getFramePacer to tune it).
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
     ////////////////////////////////////////////////////////////
     void setFramerateLimit(unsigned int limit);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frame pacer used to limit the framerate
+    ///
+    /// It gives access to the frame time histogram, to the
+    /// missed deadline callback and to the spin threshold.
+    /// Frames are only recorded while a framerate limit is set.
+    ///
+    /// \return Frame pacer of the window
+    ///
+    /// \see setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer& getFramePacer();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the joystick threshold
     ///
@@ -488,6 +597,16 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window contents are displayed
+    ///
+    /// This function is called so that derived classes can
+    /// finish their pending rendering before the back buffer
+    /// is presented on screen.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -515,8 +634,7 @@ private:
     ////////////////////////////////////////////////////////////
     priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
     priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
+    FramePacer        m_framePacer;     ///< Frame pacer enforcing the framerate limit
     Vector2u          m_size;           ///< Current size of the window
 };
 
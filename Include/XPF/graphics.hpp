@@ -31,6 +31,7 @@
 
 #include <XPF/Window.hpp>
 #include <XPF/Graphics/BlendMode.hpp>
+#include <XPF/Graphics/ChunkedVertexArray.hpp>
 #include <XPF/Graphics/CircleShape.hpp>
 #include <XPF/Graphics/Color.hpp>
 #include <XPF/Graphics/ConvexShape.hpp>
@@ -38,22 +39,29 @@
 #include <XPF/Graphics/Font.hpp>
 #include <XPF/Graphics/Glyph.hpp>
 #include <XPF/Graphics/Image.hpp>
+#include <XPF/Graphics/ImageReadback.hpp>
 #include <XPF/Graphics/PrimitiveType.hpp>
 #include <XPF/Graphics/Rect.hpp>
 #include <XPF/Graphics/RectangleShape.hpp>
+#include <XPF/Graphics/RenderQueue.hpp>
 #include <XPF/Graphics/RenderStates.hpp>
+#include <XPF/Graphics/RenderStatistics.hpp>
 #include <XPF/Graphics/RenderTarget.hpp>
 #include <XPF/Graphics/RenderTexture.hpp>
 #include <XPF/Graphics/RenderWindow.hpp>
 #include <XPF/Graphics/Shader.hpp>
 #include <XPF/Graphics/Shape.hpp>
 #include <XPF/Graphics/Sprite.hpp>
+#include <XPF/Graphics/SpriteBatch.hpp>
+#include <XPF/Graphics/StreamingTexture.hpp>
 #include <XPF/Graphics/Text.hpp>
 #include <XPF/Graphics/Texture.hpp>
+#include <XPF/Graphics/TextureAtlas.hpp>
 #include <XPF/Graphics/Transform.hpp>
 #include <XPF/Graphics/Transformable.hpp>
 #include <XPF/Graphics/Vertex.hpp>
 #include <XPF/Graphics/VertexArray.hpp>
+#include <XPF/Graphics/VertexBuffer.hpp>
 #include <XPF/Graphics/View.hpp>
 
 
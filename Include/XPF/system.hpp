@@ -33,6 +33,7 @@
 #include <XPF/System/Clock.hpp>
 #include <XPF/System/Err.hpp>
 #include <XPF/System/FileInputStream.hpp>
+#include <XPF/System/FramePacer.hpp>
 #include <XPF/System/InputStream.hpp>
 #include <XPF/System/Lock.hpp>
 #include <XPF/System/MemoryInputStream.hpp>
@@ -31,11 +31,13 @@
 
 #include <XPF/System.hpp>
 #include <XPF/Window/Context.hpp>
+#include <XPF/Window/ContextPool.hpp>
 #include <XPF/Window/ContextSettings.hpp>
 #include <XPF/Window/Event.hpp>
 #include <XPF/Window/Joystick.hpp>
 #include <XPF/Window/Keyboard.hpp>
 #include <XPF/Window/Mouse.hpp>
+#include <XPF/Window/RawEvent.hpp>
 #include <XPF/Window/Sensor.hpp>
 #include <XPF/Window/Touch.hpp>
 #include <XPF/Window/VideoMode.hpp>
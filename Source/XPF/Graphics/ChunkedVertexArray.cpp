@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/ChunkedVertexArray.hpp>
+#include <XPF/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Round the chunk size to a multiple of the number of vertices of lines (2), triangles (3) and quads (4)
+    std::size_t roundChunkSize(std::size_t chunkSize)
+    {
+        return std::max<std::size_t>((chunkSize + 11) / 12 * 12, 12);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ChunkedVertexArray::ChunkedVertexArray() :
+m_vertices        (),
+m_primitiveType   (Points),
+m_chunkSize       (roundChunkSize(1536)),
+m_chunkBounds     (),
+m_chunkNeedUpdate (),
+m_boundsNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ChunkedVertexArray::ChunkedVertexArray(PrimitiveType type, std::size_t vertexCount, std::size_t chunkSize) :
+m_vertices        (vertexCount),
+m_primitiveType   (type),
+m_chunkSize       (roundChunkSize(chunkSize)),
+m_chunkBounds     (),
+m_chunkNeedUpdate (),
+m_boundsNeedUpdate(false)
+{
+    updateChunkCount();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ChunkedVertexArray::getVertexCount() const
+{
+    return m_vertices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ChunkedVertexArray::getChunkSize() const
+{
+    return m_chunkSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ChunkedVertexArray::getChunkCount() const
+{
+    return m_chunkBounds.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex& ChunkedVertexArray::operator [](std::size_t index)
+{
+    // The caller may move the vertex
+    invalidate(index);
+
+    return m_vertices[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vertex& ChunkedVertexArray::operator [](std::size_t index) const
+{
+    return m_vertices[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::clear()
+{
+    m_vertices.clear();
+    updateChunkCount();
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::resize(std::size_t vertexCount)
+{
+    std::size_t previousCount = m_vertices.size();
+
+    m_vertices.resize(vertexCount);
+    updateChunkCount();
+
+    // The last chunk that existed before has gained or lost vertices
+    if ((vertexCount > 0) && (previousCount > 0))
+        invalidate(std::min(previousCount, vertexCount) - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::append(const Vertex& vertex)
+{
+    m_vertices.push_back(vertex);
+    updateChunkCount();
+    invalidate(m_vertices.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::setPrimitiveType(PrimitiveType type)
+{
+    if (type != m_primitiveType)
+    {
+        m_primitiveType = type;
+
+        // The overlap between chunks depends on the primitive type
+        invalidateBounds();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType ChunkedVertexArray::getPrimitiveType() const
+{
+    return m_primitiveType;
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::invalidateBounds()
+{
+    m_chunkNeedUpdate.assign(m_chunkNeedUpdate.size(), true);
+    m_boundsNeedUpdate = !m_chunkNeedUpdate.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect ChunkedVertexArray::getBounds() const
+{
+    if (m_chunkBounds.empty())
+        return FloatRect();
+
+    ensureBoundsUpdate();
+
+    float left   = m_chunkBounds[0].left;
+    float top    = m_chunkBounds[0].top;
+    float right  = m_chunkBounds[0].left + m_chunkBounds[0].width;
+    float bottom = m_chunkBounds[0].top + m_chunkBounds[0].height;
+
+    for (std::size_t i = 1; i < m_chunkBounds.size(); ++i)
+    {
+        const FloatRect& bounds = m_chunkBounds[i];
+        left   = std::min(left, bounds.left);
+        top    = std::min(top, bounds.top);
+        right  = std::max(right, bounds.left + bounds.width);
+        bottom = std::max(bottom, bounds.top + bounds.height);
+    }
+
+    return FloatRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_vertices.empty())
+        return;
+
+    if (!target.isCullingEnabled())
+    {
+        target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+        return;
+    }
+
+    // Fans can't be split, they are drawn (or skipped) as a whole
+    if (m_primitiveType == TrianglesFan)
+    {
+        if (!target.isCulled(getBounds(), states.transform))
+            target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+        return;
+    }
+
+    ensureBoundsUpdate();
+
+    // Draw each run of consecutive visible chunks with a single call
+    std::size_t overlap = getOverlap();
+    std::size_t chunkCount = m_chunkBounds.size();
+    std::size_t chunk = 0;
+    while (chunk < chunkCount)
+    {
+        // Skip the invisible chunks
+        while ((chunk < chunkCount) && target.isCulled(m_chunkBounds[chunk], states.transform))
+            ++chunk;
+
+        if (chunk == chunkCount)
+            break;
+
+        // Find the end of the run
+        std::size_t first = chunk;
+        while ((chunk < chunkCount) && !target.isCulled(m_chunkBounds[chunk], states.transform))
+            ++chunk;
+
+        // Strips need the last vertices of the previous chunk
+        std::size_t begin = first * m_chunkSize;
+        begin = begin > overlap ? begin - overlap : 0;
+        std::size_t end = std::min(chunk * m_chunkSize, m_vertices.size());
+
+        target.draw(&m_vertices[begin], end - begin, m_primitiveType, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ChunkedVertexArray::getOverlap() const
+{
+    switch (m_primitiveType)
+    {
+        case LinesStrip:     return 1;
+        case TrianglesStrip: return 2;
+        default:             return 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::invalidate(std::size_t index)
+{
+    std::size_t chunk = index / m_chunkSize;
+    m_chunkNeedUpdate[chunk] = true;
+
+    // The last vertices of a chunk are also used by the next one with strips
+    if ((index % m_chunkSize + getOverlap() >= m_chunkSize) && (chunk + 1 < m_chunkNeedUpdate.size()))
+        m_chunkNeedUpdate[chunk + 1] = true;
+
+    m_boundsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::updateChunkCount()
+{
+    std::size_t chunkCount = (m_vertices.size() + m_chunkSize - 1) / m_chunkSize;
+
+    if (chunkCount > m_chunkBounds.size())
+        m_boundsNeedUpdate = true;
+
+    // New chunks need their bounds computed
+    m_chunkBounds.resize(chunkCount);
+    m_chunkNeedUpdate.resize(chunkCount, true);
+}
+
+
+////////////////////////////////////////////////////////////
+void ChunkedVertexArray::ensureBoundsUpdate() const
+{
+    if (!m_boundsNeedUpdate)
+        return;
+
+    std::size_t overlap = getOverlap();
+    for (std::size_t chunk = 0; chunk < m_chunkBounds.size(); ++chunk)
+    {
+        if (!m_chunkNeedUpdate[chunk])
+            continue;
+
+        std::size_t begin = chunk * m_chunkSize;
+        begin = begin > overlap ? begin - overlap : 0;
+        std::size_t end = std::min((chunk + 1) * m_chunkSize, m_vertices.size());
+
+        float left   = m_vertices[begin].position.x;
+        float top    = m_vertices[begin].position.y;
+        float right  = m_vertices[begin].position.x;
+        float bottom = m_vertices[begin].position.y;
+
+        for (std::size_t i = begin + 1; i < end; ++i)
+        {
+            const Vector2f& position = m_vertices[i].position;
+            left   = std::min(left, position.x);
+            top    = std::min(top, position.y);
+            right  = std::max(right, position.x);
+            bottom = std::max(bottom, position.y);
+        }
+
+        m_chunkBounds[chunk] = FloatRect(left, top, right - left, bottom - top);
+        m_chunkNeedUpdate[chunk] = false;
+    }
+
+    m_boundsNeedUpdate = false;
+}
+
+} // namespace sf
@@ -26,7 +26,76 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <XPF/Graphics/CircleShape.hpp>
+#include <XPF/System/Mutex.hpp>
+#include <XPF/System/Lock.hpp>
 #include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    // Points of a circle of radius 1, shared by all the circles with the same point count
+    struct UnitCircle
+    {
+        std::vector<sf::Vector2f> points;
+        unsigned int              references;
+    };
+
+    typedef std::map<std::size_t, UnitCircle> UnitCircleTable;
+
+    // The table and its mutex are function-local statics, so that circles
+    // created during static initialization find them already constructed
+    UnitCircleTable& getUnitCircles()
+    {
+        static UnitCircleTable unitCircles;
+        return unitCircles;
+    }
+
+    sf::Mutex& getMutex()
+    {
+        static sf::Mutex mutex;
+        return mutex;
+    }
+
+    // Get the unit circle with the given point count, computing it if it is not used yet
+    const sf::Vector2f* acquireUnitCircle(std::size_t pointCount)
+    {
+        if (pointCount == 0)
+            return NULL;
+
+        sf::Lock lock(getMutex());
+
+        UnitCircle& circle = getUnitCircles()[pointCount];
+        if (circle.references++ == 0)
+        {
+            static const float pi = 3.141592654f;
+
+            circle.points.resize(pointCount);
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                float angle = i * 2 * pi / pointCount - pi / 2;
+                circle.points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+            }
+        }
+
+        return &circle.points[0];
+    }
+
+    // Release a unit circle, destroying it if it is no longer used
+    void releaseUnitCircle(std::size_t pointCount)
+    {
+        if (pointCount == 0)
+            return;
+
+        sf::Lock lock(getMutex());
+
+        UnitCircleTable& unitCircles = getUnitCircles();
+        UnitCircleTable::iterator it = unitCircles.find(pointCount);
+        if ((it != unitCircles.end()) && (--it->second.references == 0))
+            unitCircles.erase(it);
+    }
+}
 
 
 namespace sf
@@ -34,12 +103,49 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitPoints(acquireUnitCircle(pointCount))
 {
     update();
 }
 
 
+////////////////////////////////////////////////////////////
+CircleShape::CircleShape(const CircleShape& copy) :
+Shape       (copy),
+m_radius    (copy.m_radius),
+m_pointCount(copy.m_pointCount),
+m_unitPoints(acquireUnitCircle(copy.m_pointCount))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CircleShape::~CircleShape()
+{
+    releaseUnitCircle(m_pointCount);
+}
+
+
+////////////////////////////////////////////////////////////
+CircleShape& CircleShape::operator =(const CircleShape& right)
+{
+    Shape::operator =(right);
+
+    if (right.m_pointCount != m_pointCount)
+    {
+        const Vector2f* unitPoints = acquireUnitCircle(right.m_pointCount);
+        releaseUnitCircle(m_pointCount);
+        m_unitPoints = unitPoints;
+        m_pointCount = right.m_pointCount;
+    }
+
+    m_radius = right.m_radius;
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 void CircleShape::setRadius(float radius)
 {
@@ -58,7 +164,14 @@ float CircleShape::getRadius() const
 ////////////////////////////////////////////////////////////
 void CircleShape::setPointCount(std::size_t count)
 {
-    m_pointCount = count;
+    if (count != m_pointCount)
+    {
+        const Vector2f* unitPoints = acquireUnitCircle(count);
+        releaseUnitCircle(m_pointCount);
+        m_unitPoints = unitPoints;
+        m_pointCount = count;
+    }
+
     update();
 }
 
@@ -72,13 +185,18 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
+    return Vector2f(m_radius + m_unitPoints[index].x * m_radius, m_radius + m_unitPoints[index].y * m_radius);
+}
 
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
 
-    return Vector2f(m_radius + x, m_radius + y);
+////////////////////////////////////////////////////////////
+void CircleShape::getPoints(Vector2f* points) const
+{
+    for (std::size_t i = 0; i < m_pointCount; ++i)
+    {
+        points[i].x = m_radius + m_unitPoints[i].x * m_radius;
+        points[i].y = m_radius + m_unitPoints[i].y * m_radius;
+    }
 }
 
 } // namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <XPF/Graphics/Font.hpp>
 #include <XPF/Graphics/GLCheck.hpp>
+#include <XPF/Graphics/GlyphRasterizer.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
@@ -34,9 +35,7 @@
 #include <XPF/System/Err.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
-#include FT_GLYPH_H
-#include FT_OUTLINE_H
-#include FT_BITMAP_H
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -62,6 +61,34 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Glyph pages don't grow beyond this size: every growth re-uploads the
+    // whole page, so new pages are started instead of growing huge textures
+    const unsigned int maxPageSize = 2048;
+
+    // Fill a RGBA pixel buffer with transparent white
+    void createPixels(std::vector<sf::Uint8>& pixels, unsigned int width, unsigned int height)
+    {
+        pixels.assign(width * height * 4, 255);
+        for (std::size_t i = 3; i < pixels.size(); i += 4)
+            pixels[i] = 0;
+    }
+
+    // Scramble the bits of a cache key, so that close keys (consecutive
+    // code points) are spread over the whole hash table
+    std::size_t hashKey(sf::Uint64 key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<std::size_t>(key);
+    }
+
+    // Build the glyph cache key: code point in the lower bits, then the bold flag and the character size
+    sf::Uint64 glyphKey(sf::Uint32 codePoint, unsigned int characterSize, bool bold)
+    {
+        return (static_cast<sf::Uint64>(characterSize) << 33) | (static_cast<sf::Uint64>(bold ? 1 : 0) << 32) | codePoint;
+    }
 }
 
 
@@ -69,11 +96,17 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_refCount (NULL),
-m_info     ()
+m_library      (NULL),
+m_face         (NULL),
+m_streamRec    (NULL),
+m_refCount     (NULL),
+m_info         (),
+m_lastAtlas    (NULL),
+m_lastSize     (0),
+m_memoryData   (NULL),
+m_memorySize   (0),
+m_rasterizer   (NULL),
+m_pendingGlyphs(0)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -83,13 +116,22 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library      (copy.m_library),
+m_face         (copy.m_face),
+m_streamRec    (copy.m_streamRec),
+m_refCount     (copy.m_refCount),
+m_info         (copy.m_info),
+m_atlases      (copy.m_atlases),
+m_lastAtlas    (NULL),
+m_lastSize     (0),
+m_glyphs       (copy.m_glyphs),
+m_glyphTable   (copy.m_glyphTable),
+m_pixelBuffer  (copy.m_pixelBuffer),
+m_filename     (copy.m_filename),
+m_memoryData   (copy.m_memoryData),
+m_memorySize   (copy.m_memorySize),
+m_rasterizer   (NULL),
+m_pendingGlyphs(0)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -159,6 +201,9 @@ bool Font::loadFromFile(const std::string& filename)
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
+    // Remember the source, so that background threads can open their own faces
+    m_filename = filename;
+
     return true;
 
     #else
@@ -213,6 +258,10 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
+    // Remember the source, so that background threads can open their own faces
+    m_memoryData = data;
+    m_memorySize = sizeInBytes;
+
     return true;
 }
 
@@ -293,25 +342,71 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    // Search the glyph into the cache
+    const Glyph* glyph = findGlyph(codePoint, characterSize, bold);
+    if (glyph)
+        return *glyph;
+
+    // Not found: it may have been rasterized in the background already
+    if (m_pendingGlyphs > 0)
+    {
+        collectGlyphs();
+        glyph = findGlyph(codePoint, characterSize, bold);
+        if (glyph)
+            return *glyph;
+    }
+
+    // Still not found: we have to load it
+    return storeGlyph(codePoint, characterSize, bold, loadGlyph(codePoint, characterSize, bold));
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold) const
+{
+    for (std::size_t i = 0; i < characters.getSize(); ++i)
+        getGlyph(characters[i], characterSize, bold);
+}
 
-    // Build the key by combining the code point and the bold flag
-    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
 
-    // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+////////////////////////////////////////////////////////////
+void Font::requestGlyphs(const String& characters, unsigned int characterSize, bool bold) const
+{
+    if (!m_face)
+        return;
+
+    // Fonts loaded from a stream can't be opened again by the workers
+    if (m_filename.empty() && !m_memoryData)
     {
-        // Found: just return it
-        return it->second;
+        preloadGlyphs(characters, characterSize, bold);
+        return;
     }
-    else
+
+    // Request the glyphs that are not loaded yet
+    std::vector<priv::GlyphRasterizer::Request> requests;
+    for (std::size_t i = 0; i < characters.getSize(); ++i)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        if (!findGlyph(characters[i], characterSize, bold))
+        {
+            priv::GlyphRasterizer::Request request = {characters[i], characterSize, bold};
+            requests.push_back(request);
+        }
     }
+
+    if (requests.empty())
+        return;
+
+    // Start the workers the first time glyphs are requested
+    if (!m_rasterizer)
+    {
+        if (m_memoryData)
+            m_rasterizer = new priv::GlyphRasterizer(m_memoryData, m_memorySize);
+        else
+            m_rasterizer = new priv::GlyphRasterizer(m_filename);
+    }
+
+    m_pendingGlyphs += static_cast<unsigned int>(requests.size());
+    m_rasterizer->push(requests);
 }
 
 
@@ -324,22 +419,37 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    if (face && FT_HAS_KERNING(face))
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        // Look for the pair in the kerning values already computed for this size
+        FlatTable& table = getAtlas(characterSize).kerning;
+        Uint64 key = (static_cast<Uint64>(first) << 32) | second;
+        const Uint32* value = table.find(key);
+        Int32 kerning = 0;
+        if (value)
+        {
+            kerning = static_cast<Int32>(*value);
+        }
+        else if (setCurrentSize(characterSize))
+        {
+            // Convert the characters to indices
+            FT_UInt index1 = FT_Get_Char_Index(face, first);
+            FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+            // Get the kerning vector
+            FT_Vector vector;
+            FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &vector);
+            kerning = static_cast<Int32>(vector.x);
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+            table.insert(key, static_cast<Uint32>(kerning));
+        }
 
         // X advance is already in pixels for bitmap fonts
         if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+            return static_cast<float>(kerning);
 
         // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+        return static_cast<float>(kerning) / static_cast<float>(1 << 6);
     }
     else
     {
@@ -408,7 +518,27 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    return getTexture(characterSize, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getTexture(unsigned int characterSize, unsigned int page) const
+{
+    Atlas& atlas = getAtlas(characterSize);
+    if (page >= atlas.pages.size())
+        page = 0;
+
+    uploadPage(atlas.pages[page]);
+
+    return atlas.pages[page].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getPageCount(unsigned int characterSize) const
+{
+    return static_cast<unsigned int>(getAtlas(characterSize).pages.size());
 }
 
 
@@ -417,21 +547,50 @@ Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_library,       temp.m_library);
+    std::swap(m_face,          temp.m_face);
+    std::swap(m_streamRec,     temp.m_streamRec);
+    std::swap(m_refCount,      temp.m_refCount);
+    std::swap(m_info,          temp.m_info);
+    std::swap(m_atlases,       temp.m_atlases);
+    std::swap(m_glyphs,        temp.m_glyphs);
+    std::swap(m_glyphTable,    temp.m_glyphTable);
+    std::swap(m_pixelBuffer,   temp.m_pixelBuffer);
+    std::swap(m_filename,      temp.m_filename);
+    std::swap(m_memoryData,    temp.m_memoryData);
+    std::swap(m_memorySize,    temp.m_memorySize);
+    std::swap(m_rasterizer,    temp.m_rasterizer);
+    std::swap(m_pendingGlyphs, temp.m_pendingGlyphs);
+
+    // The last atlas now belongs to the temporary font
+    m_lastAtlas = NULL;
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+Font::Atlas& Font::getAtlas(unsigned int characterSize) const
+{
+    // Consecutive requests are almost always for the same size: skip the map search then
+    if (!m_lastAtlas || (m_lastSize != characterSize))
+    {
+        m_lastAtlas = &m_atlases[characterSize];
+        m_lastSize  = characterSize;
+    }
+
+    return *m_lastAtlas;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Stop the background rasterization
+    delete m_rasterizer;
+    m_rasterizer    = NULL;
+    m_pendingGlyphs = 0;
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -463,11 +622,72 @@ void Font::cleanup()
     m_face      = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
-    m_pages.clear();
+    m_atlases.clear();
+    m_lastAtlas = NULL;
+    m_glyphs.clear();
+    m_glyphTable.clear();
+    m_filename.clear();
+    m_memoryData = NULL;
+    m_memorySize = 0;
     m_pixelBuffer.clear();
 }
 
 
+////////////////////////////////////////////////////////////
+const Glyph* Font::findGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
+{
+    // Fast path for ASCII characters: a direct lookup in the character size's table
+    if (codePoint < 128)
+    {
+        Uint32 index = getAtlas(characterSize).ascii[(bold ? 128 : 0) + codePoint];
+        return index ? &m_glyphs[index - 1] : NULL;
+    }
+
+    const Uint32* index = m_glyphTable.find(glyphKey(codePoint, characterSize, bold));
+    return index ? &m_glyphs[*index] : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::storeGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, const Glyph& glyph) const
+{
+    m_glyphs.push_back(glyph);
+
+    if (codePoint < 128)
+        getAtlas(characterSize).ascii[(bold ? 128 : 0) + codePoint] = static_cast<Uint32>(m_glyphs.size());
+    else
+        m_glyphTable.insert(glyphKey(codePoint, characterSize, bold), static_cast<Uint32>(m_glyphs.size() - 1));
+
+    return m_glyphs.back();
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::collectGlyphs() const
+{
+    std::vector<priv::GlyphRasterizer::Result> results;
+    m_rasterizer->collect(results);
+
+    for (std::vector<priv::GlyphRasterizer::Result>::iterator it = results.begin(); it != results.end(); ++it)
+    {
+        if (m_pendingGlyphs > 0)
+            m_pendingGlyphs--;
+
+        // Skip the glyphs that failed, and those that were loaded synchronously in the meantime
+        const priv::GlyphRasterizer::Request& request = it->request;
+        if (!it->valid || findGlyph(request.codePoint, request.characterSize, request.bold))
+            continue;
+
+        // Add the pixels to the font's pages (here, on the thread that uses the textures)
+        Glyph glyph = it->glyph;
+        if ((it->width > 0) && (it->height > 0))
+            placeGlyph(glyph, request.characterSize, &it->pixels[0], it->width, it->height);
+
+        storeGlyph(request.codePoint, request.characterSize, request.bold, glyph);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
@@ -483,187 +703,194 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
-        return glyph;
+    // Rasterize the glyph (the same way as the background workers)
+    unsigned int width;
+    unsigned int height;
+    if (!priv::GlyphRasterizer::rasterize(m_library, m_face, codePoint, bold, glyph, m_pixelBuffer, width, height))
+        return Glyph();
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+    if ((width > 0) && (height > 0))
+        placeGlyph(glyph, characterSize, &m_pixelBuffer[0], width, height);
 
-    // Apply bold if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (bold && outline)
-    {
-        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-        FT_Outline_Embolden(&outlineGlyph->outline, weight);
-    }
+    // Done :)
+    return glyph;
+}
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (bold && !outline)
+////////////////////////////////////////////////////////////
+void Font::placeGlyph(Glyph& glyph, unsigned int characterSize, const Uint8* pixels, unsigned int width, unsigned int height) const
+{
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int padding = 1;
+
+    // Get the glyphs corresponding to the character size
+    Atlas& atlas = getAtlas(characterSize);
+
+    // Find a good position for the new glyph into the texture
+    glyph.textureRect = findGlyphRect(atlas, width + 2 * padding, height + 2 * padding, glyph.page);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    glyph.textureRect.left += padding;
+    glyph.textureRect.top += padding;
+    glyph.textureRect.width -= 2 * padding;
+    glyph.textureRect.height -= 2 * padding;
+
+    // Write the pixels to the page
+    unsigned int x = glyph.textureRect.left;
+    unsigned int y = glyph.textureRect.top;
+    unsigned int w = glyph.textureRect.width;
+    unsigned int h = glyph.textureRect.height;
+    Page& page = atlas.pages[glyph.page];
+
+    // Only the CPU copy of the page is written here; the modified rows are
+    // uploaded all at once when the page's texture is requested (see uploadPage)
+    unsigned int pageWidth = page.texture.getSize().x;
+    for (unsigned int i = 0; i < h; ++i)
+        std::memcpy(&page.pixels[((y + i) * pageWidth + x) * 4], &pixels[i * w * 4], w * 4);
+
+    if (page.dirtyTop == page.dirtyBottom)
     {
-        FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        page.dirtyTop    = y;
+        page.dirtyBottom = y + h;
     }
-
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
-
-    int width  = bitmap.width;
-    int height = bitmap.rows;
-
-    if ((width > 0) && (height > 0))
+    else
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
-
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
-
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
-
-        // Compute the glyph's bounding box
-        glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  = static_cast<float>(face->glyph->metrics.width) / static_cast<float>(1 << 6);
-        glyph.bounds.height = static_cast<float>(face->glyph->metrics.height) / static_cast<float>(1 << 6);
-
-        // Extract the glyph's pixels from the bitmap
-        m_pixelBuffer.resize(width * height * 4, 255);
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            // Pixels are 1 bit monochrome values
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-        else
-        {
-            // Pixels are 8 bits gray levels
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = pixels[x];
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left;
-        unsigned int y = glyph.textureRect.top;
-        unsigned int w = glyph.textureRect.width;
-        unsigned int h = glyph.textureRect.height;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+        page.dirtyTop    = std::min(page.dirtyTop, y);
+        page.dirtyBottom = std::max(page.dirtyBottom, y + h);
     }
-
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
-
-    // Force an OpenGL flush, so that the font's texture will appear updated
-    // in all contexts immediately (solves problems in multi-threaded apps)
-    glCheck(glFlush());
-
-    // Done :)
-    return glyph;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+IntRect Font::findGlyphRect(Atlas& atlas, unsigned int width, unsigned int height, unsigned int& page) const
 {
-    // Find the line that fits well the glyph
+    // Find the row that fits the glyph best. Rows with room left are indexed
+    // by height, so only the rows between the glyph's height and the tallest
+    // acceptable one (ratio of 0.7) are visited, smallest first
     Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
+    RowIndex::iterator rowIt;
+    unsigned int maxRowHeight = static_cast<unsigned int>(height / 0.7f);
+    for (std::size_t i = 0; (i < atlas.pages.size()) && !row; ++i)
     {
-        float ratio = static_cast<float>(height) / it->height;
-
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
-
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
-
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
-
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
+        Page& current = atlas.pages[i];
+        RowIndex::iterator end = current.openRows.upper_bound(maxRowHeight);
+        for (RowIndex::iterator it = current.openRows.lower_bound(height); it != end; ++it)
+        {
+            // Check if there's enough horizontal space left in the row
+            Row& candidate = current.rows[it->second];
+            if (width <= current.texture.getSize().x - candidate.width)
+            {
+                row = &candidate;
+                rowIt = it;
+                page = static_cast<unsigned int>(i);
+                break;
+            }
+        }
     }
 
     // If we didn't find a matching row, create a new one (10% taller than the glyph)
     if (!row)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        unsigned int rowHeight = height + height / 10;
+
+        // New rows go to the last page; when it is full, start a new page
+        page = static_cast<unsigned int>(atlas.pages.size() - 1);
+        if (!makeRoom(atlas.pages[page], width, rowHeight))
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
-            }
-            else
+            atlas.pages.resize(atlas.pages.size() + 1);
+            page = static_cast<unsigned int>(atlas.pages.size() - 1);
+            if (!makeRoom(atlas.pages[page], width, rowHeight))
             {
-                // Oops, we've reached the maximum texture size...
+                // Oops, even an empty page is too small...
+                atlas.pages.pop_back();
+                page = 0;
                 err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
                 return IntRect(0, 0, 2, 2);
             }
         }
 
         // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+        Page& target = atlas.pages[page];
+        target.rows.push_back(Row(target.nextRow, rowHeight));
+        target.nextRow += rowHeight;
+        rowIt = target.openRows.insert(std::make_pair(rowHeight, target.rows.size() - 1));
+        row = &target.rows.back();
     }
 
     // Find the glyph's rectangle on the selected row
     IntRect rect(row->width, row->top, width, height);
 
-    // Update the row informations
+    // Update the row informations, and stop offering it once it's (almost) full
     row->width += width;
+    if (atlas.pages[page].texture.getSize().x - row->width < row->height / 4)
+        atlas.pages[page].openRows.erase(rowIt);
 
     return rect;
 }
 
 
+////////////////////////////////////////////////////////////
+bool Font::makeRoom(Page& page, unsigned int width, unsigned int rowHeight) const
+{
+    const unsigned int maximumSize = std::min(Texture::getMaximumSize(), maxPageSize);
+
+    while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+    {
+        // Not enough space: resize the texture if possible
+        unsigned int textureWidth  = page.texture.getSize().x;
+        unsigned int textureHeight = page.texture.getSize().y;
+        if ((textureWidth * 2 > maximumSize) || (textureHeight * 2 > maximumSize))
+            return false;
+
+        // Make the texture 2 times bigger; its previous contents are taken
+        // from the CPU copy of the page, the texture is never read back
+        if (!page.texture.create(textureWidth * 2, textureHeight * 2))
+            return false;
+
+        std::vector<Uint8> pixels;
+        createPixels(pixels, textureWidth * 2, textureHeight * 2);
+        for (unsigned int y = 0; y < textureHeight; ++y)
+            std::memcpy(&pixels[y * textureWidth * 2 * 4], &page.pixels[y * textureWidth * 4], textureWidth * 4);
+        page.pixels.swap(pixels);
+
+        // The new texture is uploaded entirely the next time it is requested
+        page.dirtyTop    = 0;
+        page.dirtyBottom = textureHeight * 2;
+
+        // The rows are now wider: the full ones may accept glyphs again
+        page.openRows.clear();
+        for (std::size_t i = 0; i < page.rows.size(); ++i)
+        {
+            if (textureWidth * 2 - page.rows[i].width >= page.rows[i].height / 4)
+                page.openRows.insert(std::make_pair(page.rows[i].height, i));
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::uploadPage(Page& page) const
+{
+    if (page.dirtyTop == page.dirtyBottom)
+        return;
+
+    // Upload the band of rows modified since the last upload: full rows
+    // are contiguous in the CPU copy, so no intermediate buffer is needed
+    unsigned int width = page.texture.getSize().x;
+    page.texture.update(&page.pixels[page.dirtyTop * width * 4], width, page.dirtyBottom - page.dirtyTop, 0, page.dirtyTop);
+    page.dirtyTop    = 0;
+    page.dirtyBottom = 0;
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Font::setCurrentSize(unsigned int characterSize) const
 {
@@ -702,20 +929,105 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+nextRow    (3),
+dirtyTop   (0),
+dirtyBottom(0)
 {
     // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    createPixels(pixels, 128, 128);
 
     // Reserve a 2x2 white square for texturing underlines
     for (int x = 0; x < 2; ++x)
         for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
+            pixels[(x + y * 128) * 4 + 3] = 255;
 
     // Create the texture
-    texture.loadFromImage(image);
+    texture.create(128, 128);
+    texture.update(&pixels[0]);
     texture.setSmooth(true);
 }
 
+
+////////////////////////////////////////////////////////////
+Font::Atlas::Atlas() :
+pages(1)
+{
+    std::fill(ascii, ascii + 256, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::FlatTable::FlatTable() :
+m_count(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint32* Font::FlatTable::find(Uint64 key) const
+{
+    if (m_slots.empty())
+        return NULL;
+
+    // Linear probing: walk from the key's slot until the key or an empty slot is found
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = hashKey(key) & mask; ; i = (i + 1) & mask)
+    {
+        const Slot& slot = m_slots[i];
+        if (!slot.used)
+            return NULL;
+        if (slot.key == key)
+            return &slot.value;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::FlatTable::insert(Uint64 key, Uint32 value)
+{
+    // Keep the table at most half full, so that probe sequences stay short
+    if ((m_count + 1) * 2 > m_slots.size())
+        grow();
+
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = hashKey(key) & mask;
+    while (m_slots[i].used && (m_slots[i].key != key))
+        i = (i + 1) & mask;
+
+    if (!m_slots[i].used)
+        m_count++;
+
+    m_slots[i].key   = key;
+    m_slots[i].value = value;
+    m_slots[i].used  = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::FlatTable::clear()
+{
+    m_slots.clear();
+    m_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::FlatTable::grow()
+{
+    Slot empty;
+    empty.key   = 0;
+    empty.value = 0;
+    empty.used  = false;
+
+    std::vector<Slot> slots(m_slots.empty() ? 64 : m_slots.size() * 2, empty);
+    slots.swap(m_slots);
+    m_count = 0;
+
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if (slots[i].used)
+            insert(slots[i].key, slots[i].value);
+    }
+}
+
 } // namespace sf
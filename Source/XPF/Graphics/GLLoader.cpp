@@ -46,6 +46,14 @@ int sfogl_ext_ARB_fragment_shader = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_texture_non_power_of_two = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+int sfogl_ext_VERSION_2_0 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -798,6 +806,337 @@ static int Load_EXT_framebuffer_object()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void*, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint) = NULL;
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum) = NULL;
+
+static int Load_ARB_vertex_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindBufferARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindBufferARB"));
+    if (!sf_ptrc_glBindBufferARB)
+        numFailed++;
+
+    sf_ptrc_glBufferDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptrARB, const void*, GLenum)>(glLoaderGetProcAddress("glBufferDataARB"));
+    if (!sf_ptrc_glBufferDataARB)
+        numFailed++;
+
+    sf_ptrc_glBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, const void*)>(glLoaderGetProcAddress("glBufferSubDataARB"));
+    if (!sf_ptrc_glBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteBuffersARB"));
+    if (!sf_ptrc_glDeleteBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGenBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenBuffersARB"));
+    if (!sf_ptrc_glGenBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferParameterivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetBufferParameterivARB"));
+    if (!sf_ptrc_glGetBufferParameterivARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, void*)>(glLoaderGetProcAddress("glGetBufferSubDataARB"));
+    if (!sf_ptrc_glGetBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glIsBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsBufferARB"));
+    if (!sf_ptrc_glIsBufferARB)
+        numFailed++;
+
+    sf_ptrc_glMapBufferARB = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLenum)>(glLoaderGetProcAddress("glMapBufferARB"));
+    if (!sf_ptrc_glMapBufferARB)
+        numFailed++;
+
+    sf_ptrc_glUnmapBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glUnmapBufferARB"));
+    if (!sf_ptrc_glUnmapBufferARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glFenceSync = reinterpret_cast<GLsync (GL_FUNCPTR *)(GLenum, GLbitfield)>(glLoaderGetProcAddress("glFenceSync"));
+    if (!sf_ptrc_glFenceSync)
+        numFailed++;
+
+    sf_ptrc_glClientWaitSync = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glClientWaitSync"));
+    if (!sf_ptrc_glClientWaitSync)
+        numFailed++;
+
+    sf_ptrc_glDeleteSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glDeleteSync"));
+    if (!sf_ptrc_glDeleteSync)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLuint (GL_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint) = NULL;
+
+static int Load_ARB_uniform_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetUniformBlockIndex = reinterpret_cast<GLuint (GL_FUNCPTR *)(GLuint, const GLchar*)>(glLoaderGetProcAddress("glGetUniformBlockIndex"));
+    if (!sf_ptrc_glGetUniformBlockIndex)
+        numFailed++;
+
+    sf_ptrc_glUniformBlockBinding = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLuint)>(glLoaderGetProcAddress("glUniformBlockBinding"));
+    if (!sf_ptrc_glUniformBlockBinding)
+        numFailed++;
+
+    sf_ptrc_glBindBufferBase = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint, GLuint)>(glLoaderGetProcAddress("glBindBufferBase"));
+    if (!sf_ptrc_glBindBufferBase)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint) = NULL;
+
+static int Load_ARB_get_program_binary()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLenum*, void*)>(glLoaderGetProcAddress("glGetProgramBinary"));
+    if (!sf_ptrc_glGetProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glProgramBinary"));
+    if (!sf_ptrc_glProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramParameteri = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint)>(glLoaderGetProcAddress("glProgramParameteri"));
+    if (!sf_ptrc_glProgramParameteri)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGenQueries)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteQueries)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBeginQuery)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glEndQuery)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectiv)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*) = NULL;
+
+static int Load_ARB_timer_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGenQueries = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenQueries"));
+    if (!sf_ptrc_glGenQueries)
+        numFailed++;
+
+    sf_ptrc_glDeleteQueries = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteQueries"));
+    if (!sf_ptrc_glDeleteQueries)
+        numFailed++;
+
+    sf_ptrc_glBeginQuery = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBeginQuery"));
+    if (!sf_ptrc_glBeginQuery)
+        numFailed++;
+
+    sf_ptrc_glEndQuery = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glEndQuery"));
+    if (!sf_ptrc_glEndQuery)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryObjectiv"));
+    if (!sf_ptrc_glGetQueryObjectiv)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectui64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint64*)>(glLoaderGetProcAddress("glGetQueryObjectui64v"));
+    if (!sf_ptrc_glGetQueryObjectui64v)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glActiveTexture)(GLenum) = NULL;
+GLuint (GL_FUNCPTR *sf_ptrc_glCreateShader)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompileShader)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetShaderiv)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteShader)(GLuint) = NULL;
+GLuint (GL_FUNCPTR *sf_ptrc_glCreateProgram)() = NULL;
+void (GL_FUNCPTR *sf_ptrc_glAttachShader)(GLuint, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindAttribLocation)(GLuint, GLuint, const GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glLinkProgram)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetProgramiv)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteProgram)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUseProgram)(GLuint) = NULL;
+GLint (GL_FUNCPTR *sf_ptrc_glGetAttribLocation)(GLuint, const GLchar*) = NULL;
+GLint (GL_FUNCPTR *sf_ptrc_glGetUniformLocation)(GLuint, const GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform1i)(GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glEnableVertexAttribArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDisableVertexAttribArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenBuffers)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteBuffers)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindBuffer)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferData)(GLenum, GLsizeiptr, const void*, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*) = NULL;
+
+static int Load_VERSION_2_0()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glActiveTexture = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glActiveTexture"));
+    if (!sf_ptrc_glActiveTexture)
+        numFailed++;
+
+    sf_ptrc_glCreateShader = reinterpret_cast<GLuint (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glCreateShader"));
+    if (!sf_ptrc_glCreateShader)
+        numFailed++;
+
+    sf_ptrc_glShaderSource = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, const GLchar* const*, const GLint*)>(glLoaderGetProcAddress("glShaderSource"));
+    if (!sf_ptrc_glShaderSource)
+        numFailed++;
+
+    sf_ptrc_glCompileShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glCompileShader"));
+    if (!sf_ptrc_glCompileShader)
+        numFailed++;
+
+    sf_ptrc_glGetShaderiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetShaderiv"));
+    if (!sf_ptrc_glGetShaderiv)
+        numFailed++;
+
+    sf_ptrc_glGetShaderInfoLog = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLchar*)>(glLoaderGetProcAddress("glGetShaderInfoLog"));
+    if (!sf_ptrc_glGetShaderInfoLog)
+        numFailed++;
+
+    sf_ptrc_glDeleteShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDeleteShader"));
+    if (!sf_ptrc_glDeleteShader)
+        numFailed++;
+
+    sf_ptrc_glCreateProgram = reinterpret_cast<GLuint (GL_FUNCPTR *)()>(glLoaderGetProcAddress("glCreateProgram"));
+    if (!sf_ptrc_glCreateProgram)
+        numFailed++;
+
+    sf_ptrc_glAttachShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glAttachShader"));
+    if (!sf_ptrc_glAttachShader)
+        numFailed++;
+
+    sf_ptrc_glBindAttribLocation = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, const GLchar*)>(glLoaderGetProcAddress("glBindAttribLocation"));
+    if (!sf_ptrc_glBindAttribLocation)
+        numFailed++;
+
+    sf_ptrc_glLinkProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glLinkProgram"));
+    if (!sf_ptrc_glLinkProgram)
+        numFailed++;
+
+    sf_ptrc_glGetProgramiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetProgramiv"));
+    if (!sf_ptrc_glGetProgramiv)
+        numFailed++;
+
+    sf_ptrc_glGetProgramInfoLog = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLchar*)>(glLoaderGetProcAddress("glGetProgramInfoLog"));
+    if (!sf_ptrc_glGetProgramInfoLog)
+        numFailed++;
+
+    sf_ptrc_glDeleteProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDeleteProgram"));
+    if (!sf_ptrc_glDeleteProgram)
+        numFailed++;
+
+    sf_ptrc_glUseProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glUseProgram"));
+    if (!sf_ptrc_glUseProgram)
+        numFailed++;
+
+    sf_ptrc_glGetAttribLocation = reinterpret_cast<GLint (GL_FUNCPTR *)(GLuint, const GLchar*)>(glLoaderGetProcAddress("glGetAttribLocation"));
+    if (!sf_ptrc_glGetAttribLocation)
+        numFailed++;
+
+    sf_ptrc_glGetUniformLocation = reinterpret_cast<GLint (GL_FUNCPTR *)(GLuint, const GLchar*)>(glLoaderGetProcAddress("glGetUniformLocation"));
+    if (!sf_ptrc_glGetUniformLocation)
+        numFailed++;
+
+    sf_ptrc_glUniform1i = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint)>(glLoaderGetProcAddress("glUniform1i"));
+    if (!sf_ptrc_glUniform1i)
+        numFailed++;
+
+    sf_ptrc_glUniformMatrix4fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, GLboolean, const GLfloat*)>(glLoaderGetProcAddress("glUniformMatrix4fv"));
+    if (!sf_ptrc_glUniformMatrix4fv)
+        numFailed++;
+
+    sf_ptrc_glVertexAttribPointer = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*)>(glLoaderGetProcAddress("glVertexAttribPointer"));
+    if (!sf_ptrc_glVertexAttribPointer)
+        numFailed++;
+
+    sf_ptrc_glEnableVertexAttribArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glEnableVertexAttribArray"));
+    if (!sf_ptrc_glEnableVertexAttribArray)
+        numFailed++;
+
+    sf_ptrc_glDisableVertexAttribArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDisableVertexAttribArray"));
+    if (!sf_ptrc_glDisableVertexAttribArray)
+        numFailed++;
+
+    sf_ptrc_glGenBuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenBuffers"));
+    if (!sf_ptrc_glGenBuffers)
+        numFailed++;
+
+    sf_ptrc_glDeleteBuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteBuffers"));
+    if (!sf_ptrc_glDeleteBuffers)
+        numFailed++;
+
+    sf_ptrc_glBindBuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindBuffer"));
+    if (!sf_ptrc_glBindBuffer)
+        numFailed++;
+
+    sf_ptrc_glBufferData = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptr, const void*, GLenum)>(glLoaderGetProcAddress("glBufferData"));
+    if (!sf_ptrc_glBufferData)
+        numFailed++;
+
+    sf_ptrc_glBufferSubData = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, const void*)>(glLoaderGetProcAddress("glBufferSubData"));
+    if (!sf_ptrc_glBufferSubData)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -806,7 +1145,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[13] = {
+static sfogl_StrToExtMap ExtensionMap[20] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -819,10 +1158,17 @@ static sfogl_StrToExtMap ExtensionMap[13] = {
     {"GL_ARB_fragment_shader", &sfogl_ext_ARB_fragment_shader, NULL},
     {"GL_ARB_texture_non_power_of_two", &sfogl_ext_ARB_texture_non_power_of_two, NULL},
     {"GL_EXT_blend_equation_separate", &sfogl_ext_EXT_blend_equation_separate, Load_EXT_blend_equation_separate},
-    {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object}
+    {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object},
+    {"GL_ARB_vertex_buffer_object", &sfogl_ext_ARB_vertex_buffer_object, Load_ARB_vertex_buffer_object},
+    {"GL_ARB_pixel_buffer_object", &sfogl_ext_ARB_pixel_buffer_object, NULL},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync},
+    {"GL_ARB_uniform_buffer_object", &sfogl_ext_ARB_uniform_buffer_object, Load_ARB_uniform_buffer_object},
+    {"GL_ARB_get_program_binary", &sfogl_ext_ARB_get_program_binary, Load_ARB_get_program_binary},
+    {"GL_ARB_timer_query", &sfogl_ext_ARB_timer_query, Load_ARB_timer_query},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object}
 };
 
-static int g_extensionMapSize = 13;
+static int g_extensionMapSize = 20;
 
 
 static void ClearExtensionVars()
@@ -840,6 +1186,14 @@ static void ClearExtensionVars()
     sfogl_ext_ARB_texture_non_power_of_two = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+    sfogl_ext_VERSION_2_0 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
 }
 
 
@@ -856,6 +1210,28 @@ static void LoadExtension(sfogl_StrToExtMap& extension)
 }
 
 
+static void GetContextVersion(int& majorVersion, int& minorVersion)
+{
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version)
+        return;
+
+    // OpenGL ES version strings are prefixed ("OpenGL ES 2.0 ...")
+    while (*version && ((*version < '0') || (*version > '9')))
+        ++version;
+
+    majorVersion = 0;
+    while ((*version >= '0') && (*version <= '9'))
+        majorVersion = majorVersion * 10 + (*version++ - '0');
+
+    if (*version == '.')
+        ++version;
+
+    minorVersion = 0;
+    while ((*version >= '0') && (*version <= '9'))
+        minorVersion = minorVersion * 10 + (*version++ - '0');
+}
+
 void sfogl_LoadFunctions()
 {
     ClearExtensionVars();
@@ -865,4 +1241,16 @@ void sfogl_LoadFunctions()
         if (sf::Context::isExtensionAvailable(ExtensionMap[i].extensionName))
             LoadExtension(ExtensionMap[i]);
     }
+
+    // Core entry points are not advertised in the extension string,
+    // load them according to the version of the current context
+    int majorVersion = 0;
+    int minorVersion = 0;
+    GetContextVersion(majorVersion, minorVersion);
+
+    if (majorVersion >= 2)
+        sfogl_ext_VERSION_2_0 = sfogl_LOAD_SUCCEEDED + Load_VERSION_2_0();
+
+    if ((majorVersion >= 3) && (sfogl_ext_ARB_vertex_array_object == sfogl_LOAD_FAILED))
+        sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_SUCCEEDED + Load_ARB_vertex_array_object();
 }
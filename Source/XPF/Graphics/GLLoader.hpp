@@ -183,6 +183,14 @@ extern int sfogl_ext_ARB_fragment_shader;
 extern int sfogl_ext_ARB_texture_non_power_of_two;
 extern int sfogl_ext_EXT_blend_equation_separate;
 extern int sfogl_ext_EXT_framebuffer_object;
+extern int sfogl_ext_ARB_vertex_buffer_object;
+extern int sfogl_ext_ARB_pixel_buffer_object;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_ext_ARB_uniform_buffer_object;
+extern int sfogl_ext_ARB_get_program_binary;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_VERSION_2_0;
+extern int sfogl_ext_ARB_vertex_array_object;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -360,6 +368,63 @@ extern int sfogl_ext_EXT_framebuffer_object;
 #define GL_STENCIL_INDEX4_EXT 0x8D47
 #define GL_STENCIL_INDEX8_EXT 0x8D48
 
+#define GL_ARRAY_BUFFER_ARB 0x8892
+#define GL_ARRAY_BUFFER_BINDING_ARB 0x8894
+#define GL_BUFFER_ACCESS_ARB 0x88BB
+#define GL_BUFFER_MAPPED_ARB 0x88BC
+#define GL_BUFFER_MAP_POINTER_ARB 0x88BD
+#define GL_BUFFER_SIZE_ARB 0x8764
+#define GL_BUFFER_USAGE_ARB 0x8765
+#define GL_DYNAMIC_COPY_ARB 0x88EA
+#define GL_DYNAMIC_DRAW_ARB 0x88E8
+#define GL_DYNAMIC_READ_ARB 0x88E9
+#define GL_ELEMENT_ARRAY_BUFFER_ARB 0x8893
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB 0x8895
+#define GL_READ_ONLY_ARB 0x88B8
+#define GL_READ_WRITE_ARB 0x88BA
+#define GL_STATIC_COPY_ARB 0x88E6
+#define GL_STATIC_DRAW_ARB 0x88E4
+#define GL_STATIC_READ_ARB 0x88E5
+#define GL_STREAM_COPY_ARB 0x88E2
+#define GL_STREAM_DRAW_ARB 0x88E0
+#define GL_STREAM_READ_ARB 0x88E1
+#define GL_WRITE_ONLY_ARB 0x88B9
+
+#define GL_PIXEL_PACK_BUFFER_ARB 0x88EB
+#define GL_PIXEL_UNPACK_BUFFER_ARB 0x88EC
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#define GL_MAX_UNIFORM_BUFFER_BINDINGS 0x8A2F
+#define GL_UNIFORM_BUFFER 0x8A11
+
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#define GL_TIME_ELAPSED 0x88BF
+
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ARRAY_BUFFER_BINDING 0x8894
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_CURRENT_PROGRAM 0x8B8D
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_INFO_LOG_LENGTH 0x8B84
+#define GL_LINK_STATUS 0x8B82
+#define GL_STREAM_DRAW 0x88E0
+#define GL_TEXTURE0 0x84C0
+#define GL_VERTEX_SHADER 0x8B31
+
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1201,6 +1266,144 @@ extern void (GL_FUNCPTR *sf_ptrc_glRenderbufferStorageEXT)(GLenum, GLenum, GLsiz
 #define glRenderbufferStorageEXT sf_ptrc_glRenderbufferStorageEXT
 #endif // GL_EXT_framebuffer_object
 
+#ifndef GL_ARB_vertex_buffer_object
+#define GL_ARB_vertex_buffer_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint);
+#define glBindBufferARB sf_ptrc_glBindBufferARB
+extern void (GL_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void*, GLenum);
+#define glBufferDataARB sf_ptrc_glBufferDataARB
+extern void (GL_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void*);
+#define glBufferSubDataARB sf_ptrc_glBufferSubDataARB
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint*);
+#define glDeleteBuffersARB sf_ptrc_glDeleteBuffersARB
+extern void (GL_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint*);
+#define glGenBuffersARB sf_ptrc_glGenBuffersARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint*);
+#define glGetBufferParameterivARB sf_ptrc_glGetBufferParameterivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void*);
+#define glGetBufferSubDataARB sf_ptrc_glGetBufferSubDataARB
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint);
+#define glIsBufferARB sf_ptrc_glIsBufferARB
+extern void* (GL_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum);
+#define glMapBufferARB sf_ptrc_glMapBufferARB
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum);
+#define glUnmapBufferARB sf_ptrc_glUnmapBufferARB
+#endif // GL_ARB_vertex_buffer_object
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+#endif // GL_ARB_sync
+
+#ifndef GL_ARB_uniform_buffer_object
+#define GL_ARB_uniform_buffer_object 1
+extern GLuint (GL_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar*);
+#define glGetUniformBlockIndex sf_ptrc_glGetUniformBlockIndex
+extern void (GL_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint);
+#define glUniformBlockBinding sf_ptrc_glUniformBlockBinding
+extern void (GL_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint);
+#define glBindBufferBase sf_ptrc_glBindBufferBase
+#endif // GL_ARB_uniform_buffer_object
+
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+#define glGetProgramBinary sf_ptrc_glGetProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei);
+#define glProgramBinary sf_ptrc_glProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint);
+#define glProgramParameteri sf_ptrc_glProgramParameteri
+#endif // GL_ARB_get_program_binary
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glGenQueries)(GLsizei, GLuint*);
+#define glGenQueries sf_ptrc_glGenQueries
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteQueries)(GLsizei, const GLuint*);
+#define glDeleteQueries sf_ptrc_glDeleteQueries
+extern void (GL_FUNCPTR *sf_ptrc_glBeginQuery)(GLenum, GLuint);
+#define glBeginQuery sf_ptrc_glBeginQuery
+extern void (GL_FUNCPTR *sf_ptrc_glEndQuery)(GLenum);
+#define glEndQuery sf_ptrc_glEndQuery
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectiv)(GLuint, GLenum, GLint*);
+#define glGetQueryObjectiv sf_ptrc_glGetQueryObjectiv
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+#endif // GL_ARB_timer_query
+
+#ifndef GL_VERSION_2_0
+#define GL_VERSION_2_0 1
+extern void (GL_FUNCPTR *sf_ptrc_glActiveTexture)(GLenum);
+#define glActiveTexture sf_ptrc_glActiveTexture
+extern GLuint (GL_FUNCPTR *sf_ptrc_glCreateShader)(GLenum);
+#define glCreateShader sf_ptrc_glCreateShader
+extern void (GL_FUNCPTR *sf_ptrc_glShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*);
+#define glShaderSource sf_ptrc_glShaderSource
+extern void (GL_FUNCPTR *sf_ptrc_glCompileShader)(GLuint);
+#define glCompileShader sf_ptrc_glCompileShader
+extern void (GL_FUNCPTR *sf_ptrc_glGetShaderiv)(GLuint, GLenum, GLint*);
+#define glGetShaderiv sf_ptrc_glGetShaderiv
+extern void (GL_FUNCPTR *sf_ptrc_glGetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+#define glGetShaderInfoLog sf_ptrc_glGetShaderInfoLog
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteShader)(GLuint);
+#define glDeleteShader sf_ptrc_glDeleteShader
+extern GLuint (GL_FUNCPTR *sf_ptrc_glCreateProgram)();
+#define glCreateProgram sf_ptrc_glCreateProgram
+extern void (GL_FUNCPTR *sf_ptrc_glAttachShader)(GLuint, GLuint);
+#define glAttachShader sf_ptrc_glAttachShader
+extern void (GL_FUNCPTR *sf_ptrc_glBindAttribLocation)(GLuint, GLuint, const GLchar*);
+#define glBindAttribLocation sf_ptrc_glBindAttribLocation
+extern void (GL_FUNCPTR *sf_ptrc_glLinkProgram)(GLuint);
+#define glLinkProgram sf_ptrc_glLinkProgram
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramiv)(GLuint, GLenum, GLint*);
+#define glGetProgramiv sf_ptrc_glGetProgramiv
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+#define glGetProgramInfoLog sf_ptrc_glGetProgramInfoLog
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteProgram)(GLuint);
+#define glDeleteProgram sf_ptrc_glDeleteProgram
+extern void (GL_FUNCPTR *sf_ptrc_glUseProgram)(GLuint);
+#define glUseProgram sf_ptrc_glUseProgram
+extern GLint (GL_FUNCPTR *sf_ptrc_glGetAttribLocation)(GLuint, const GLchar*);
+#define glGetAttribLocation sf_ptrc_glGetAttribLocation
+extern GLint (GL_FUNCPTR *sf_ptrc_glGetUniformLocation)(GLuint, const GLchar*);
+#define glGetUniformLocation sf_ptrc_glGetUniformLocation
+extern void (GL_FUNCPTR *sf_ptrc_glUniform1i)(GLint, GLint);
+#define glUniform1i sf_ptrc_glUniform1i
+extern void (GL_FUNCPTR *sf_ptrc_glUniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+#define glUniformMatrix4fv sf_ptrc_glUniformMatrix4fv
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+#define glVertexAttribPointer sf_ptrc_glVertexAttribPointer
+extern void (GL_FUNCPTR *sf_ptrc_glEnableVertexAttribArray)(GLuint);
+#define glEnableVertexAttribArray sf_ptrc_glEnableVertexAttribArray
+extern void (GL_FUNCPTR *sf_ptrc_glDisableVertexAttribArray)(GLuint);
+#define glDisableVertexAttribArray sf_ptrc_glDisableVertexAttribArray
+extern void (GL_FUNCPTR *sf_ptrc_glGenBuffers)(GLsizei, GLuint*);
+#define glGenBuffers sf_ptrc_glGenBuffers
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteBuffers)(GLsizei, const GLuint*);
+#define glDeleteBuffers sf_ptrc_glDeleteBuffers
+extern void (GL_FUNCPTR *sf_ptrc_glBindBuffer)(GLenum, GLuint);
+#define glBindBuffer sf_ptrc_glBindBuffer
+extern void (GL_FUNCPTR *sf_ptrc_glBufferData)(GLenum, GLsizeiptr, const void*, GLenum);
+#define glBufferData sf_ptrc_glBufferData
+extern void (GL_FUNCPTR *sf_ptrc_glBufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*);
+#define glBufferSubData sf_ptrc_glBufferSubData
+#endif // GL_VERSION_2_0
+
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+#endif // GL_ARB_vertex_array_object
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/GlyphRasterizer.hpp>
+#include <XPF/System/Lock.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_OUTLINE_H
+#include FT_BITMAP_H
+
+
+namespace
+{
+    // Number of threads rasterizing glyphs for each font
+    const unsigned int workerCount = 2;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphRasterizer::GlyphRasterizer(const std::string& filename) :
+m_filename(filename),
+m_data    (NULL),
+m_size    (0),
+m_stopping(false)
+{
+    createWorkers();
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::GlyphRasterizer(const void* data, std::size_t sizeInBytes) :
+m_data    (data),
+m_size    (sizeInBytes),
+m_stopping(false)
+{
+    createWorkers();
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::~GlyphRasterizer()
+{
+    // Drop the pending requests and wake up the workers, so that they stop as soon as possible
+    {
+        Lock lock(m_mutex);
+        m_requests.clear();
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    // Wait for the workers and destroy them
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::push(const std::vector<Request>& requests)
+{
+    if (requests.empty())
+        return;
+
+    // Queue the requests and wake up the idle workers
+    {
+        Lock lock(m_mutex);
+        m_requests.insert(m_requests.end(), requests.begin(), requests.end());
+    }
+    m_condition.notify_all();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::collect(std::vector<Result>& results)
+{
+    results.clear();
+
+    Lock lock(m_mutex);
+    results.swap(m_results);
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::rasterize(void* library, void* face, Uint32 codePoint, bool bold, Glyph& glyph, std::vector<Uint8>& pixels, unsigned int& width, unsigned int& height)
+{
+    FT_Face ftFace = static_cast<FT_Face>(face);
+    width  = 0;
+    height = 0;
+
+    // Load the glyph corresponding to the code point
+    if (FT_Load_Char(ftFace, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+        return false;
+
+    // Retrieve the glyph
+    FT_Glyph glyphDesc;
+    if (FT_Get_Glyph(ftFace->glyph, &glyphDesc) != 0)
+        return false;
+
+    // Apply bold if necessary -- first technique using outline (highest quality)
+    FT_Pos weight = 1 << 6;
+    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+    if (bold && outline)
+    {
+        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+        FT_Outline_Embolden(&outlineGlyph->outline, weight);
+    }
+
+    // Convert the glyph to a bitmap (i.e. rasterize it)
+    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+    if (bold && !outline)
+    {
+        FT_Bitmap_Embolden(static_cast<FT_Library>(library), &bitmap, weight, weight);
+    }
+
+    // Compute the glyph's advance offset
+    glyph.advance = static_cast<float>(ftFace->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    if (bold)
+        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+    if ((bitmap.width > 0) && (bitmap.rows > 0))
+    {
+        width  = bitmap.width;
+        height = bitmap.rows;
+
+        // Compute the glyph's bounding box
+        glyph.bounds.left   = static_cast<float>(ftFace->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+        glyph.bounds.top    = -static_cast<float>(ftFace->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+        glyph.bounds.width  = static_cast<float>(ftFace->glyph->metrics.width) / static_cast<float>(1 << 6);
+        glyph.bounds.height = static_cast<float>(ftFace->glyph->metrics.height) / static_cast<float>(1 << 6);
+
+        // Extract the glyph's pixels from the bitmap
+        pixels.resize(width * height * 4, 255);
+        const Uint8* source = bitmap.buffer;
+        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        {
+            // Pixels are 1 bit monochrome values
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    // The color channels remain white, just fill the alpha channel
+                    std::size_t index = (x + y * width) * 4 + 3;
+                    pixels[index] = ((source[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+                }
+                source += bitmap.pitch;
+            }
+        }
+        else
+        {
+            // Pixels are 8 bits gray levels
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    // The color channels remain white, just fill the alpha channel
+                    std::size_t index = (x + y * width) * 4 + 3;
+                    pixels[index] = source[x];
+                }
+                source += bitmap.pitch;
+            }
+        }
+    }
+
+    // Delete the FT glyph
+    FT_Done_Glyph(glyphDesc);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::createWorkers()
+{
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        m_workers.push_back(new Worker(*this));
+        m_workers.back()->thread.launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::Worker::Worker(GlyphRasterizer& owner) :
+owner  (owner),
+thread (&Worker::run, this),
+library(NULL),
+face   (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::Worker::~Worker()
+{
+    thread.wait();
+
+    if (face)
+        FT_Done_Face(static_cast<FT_Face>(face));
+    if (library)
+        FT_Done_FreeType(static_cast<FT_Library>(library));
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::Worker::run()
+{
+    // Open the worker's own face once, for the whole life of the thread
+    bool ready = openFace();
+
+    Result result;
+    bool hasResult = false;
+    for (;;)
+    {
+        // Publish the previous glyph and take the next request, sleeping while there is none
+        {
+            Lock lock(owner.m_mutex);
+
+            if (hasResult)
+                owner.m_results.push_back(result);
+
+            while (owner.m_requests.empty() && !owner.m_stopping)
+                owner.m_condition.wait(owner.m_mutex);
+
+            if (owner.m_stopping)
+                return;
+
+            result.request = owner.m_requests.front();
+            owner.m_requests.pop_front();
+        }
+
+        // Rasterize the glyph with the worker's own face
+        result.glyph = Glyph();
+        result.valid = false;
+        if (ready)
+        {
+            FT_Face ftFace = static_cast<FT_Face>(face);
+            if ((ftFace->size->metrics.x_ppem == result.request.characterSize) ||
+                (FT_Set_Pixel_Sizes(ftFace, 0, result.request.characterSize) == 0))
+            {
+                result.valid = rasterize(library, face, result.request.codePoint, result.request.bold,
+                                         result.glyph, result.pixels, result.width, result.height);
+            }
+        }
+        hasResult = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::Worker::openFace()
+{
+    FT_Library ftLibrary;
+    if (FT_Init_FreeType(&ftLibrary) != 0)
+        return false;
+    library = ftLibrary;
+
+    FT_Face ftFace;
+    FT_Error error;
+    if (owner.m_data)
+        error = FT_New_Memory_Face(ftLibrary, reinterpret_cast<const FT_Byte*>(owner.m_data), static_cast<FT_Long>(owner.m_size), 0, &ftFace);
+    else
+        error = FT_New_Face(ftLibrary, owner.m_filename.c_str(), 0, &ftFace);
+    if (error != 0)
+        return false;
+
+    // Select the Unicode character map
+    if (FT_Select_Charmap(ftFace, FT_ENCODING_UNICODE) != 0)
+    {
+        FT_Done_Face(ftFace);
+        return false;
+    }
+
+    face = ftFace;
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLYPHRASTERIZER_HPP
+#define SFML_GLYPHRASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/Glyph.hpp>
+#include <XPF/System/Mutex.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <XPF/System/Thread.hpp>
+#include <condition_variable>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of threads rasterizing glyphs in the background
+///
+////////////////////////////////////////////////////////////
+class GlyphRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Request
+    {
+        Uint32       codePoint;     ///< Unicode code point of the character
+        unsigned int characterSize; ///< Reference character size
+        bool         bold;          ///< Rasterize the bold version or the regular one?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterized glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        Request            request; ///< Request that produced the glyph
+        bool               valid;   ///< Did the rasterization succeed?
+        Glyph              glyph;   ///< Metrics of the glyph (its texture rect and page are not set)
+        unsigned int       width;   ///< Width of the glyph's bitmap, in pixels
+        unsigned int       height;  ///< Height of the glyph's bitmap, in pixels
+        std::vector<Uint8> pixels;  ///< RGBA pixels of the glyph's bitmap
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool for a font file on disk
+    ///
+    /// Each worker opens its own FreeType face on the file,
+    /// so that they never share FreeType objects.
+    ///
+    /// \param filename Path of the font file
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GlyphRasterizer(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool for a font file in memory
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphRasterizer(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Pending requests are dropped, and the workers are
+    /// woken up and waited for.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue glyphs for rasterization
+    ///
+    /// Idle workers are woken up; they go back to sleep once
+    /// the queue is empty.
+    ///
+    /// \param requests Glyphs to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    void push(const std::vector<Request>& requests);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the glyphs rasterized since the last call
+    ///
+    /// \param results Array to fill with the rasterized glyphs (its previous contents are lost)
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(std::vector<Result>& results);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph with a FreeType face
+    ///
+    /// The face's character size must already be set. This
+    /// function is shared by the workers and by sf::Font's
+    /// synchronous path, so that both produce the same glyphs.
+    ///
+    /// \param library   FreeType library owning the face (FT_Library)
+    /// \param face      FreeType face to use (FT_Face)
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Rasterize the bold version or the regular one?
+    /// \param glyph     Glyph to fill with the metrics
+    /// \param pixels    Array to fill with the RGBA pixels of the bitmap
+    /// \param width     Width of the bitmap, in pixels
+    /// \param height    Height of the bitmap, in pixels
+    ///
+    /// \return True if the glyph was loaded, false if FreeType failed
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool rasterize(void* library, void* face, Uint32 codePoint, bool bold, Glyph& glyph, std::vector<Uint8>& pixels, unsigned int& width, unsigned int& height);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Worker thread and its FreeType objects
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Worker
+    {
+        Worker(GlyphRasterizer& owner);
+        ~Worker();
+
+        void run();
+        bool openFace();
+
+        GlyphRasterizer& owner;   ///< Pool owning the worker
+        Thread           thread;  ///< Thread running the worker
+        void*            library; ///< FreeType library of the worker (FT_Library)
+        void*            face;    ///< FreeType face of the worker (FT_Face)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create and start the workers
+    ///
+    ////////////////////////////////////////////////////////////
+    void createWorkers();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string                 m_filename;  ///< Path of the font file, if loaded from disk
+    const void*                 m_data;      ///< Font file data, if loaded from memory
+    std::size_t                 m_size;      ///< Size of the font file data, if loaded from memory
+    std::vector<Worker*>        m_workers;   ///< Worker threads
+    std::deque<Request>         m_requests;  ///< Glyphs waiting to be rasterized
+    std::vector<Result>         m_results;   ///< Glyphs rasterized and not collected yet
+    bool                        m_stopping;  ///< Must the workers exit? (set by the destructor)
+    Mutex                       m_mutex;     ///< Mutex protecting the queues and m_stopping
+    std::condition_variable_any m_condition; ///< Condition the idle workers wait on
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHRASTERIZER_HPP
@@ -27,14 +27,129 @@
 ////////////////////////////////////////////////////////////
 #include <XPF/Graphics/Image.hpp>
 #include <XPF/Graphics/ImageLoader.hpp>
+#include <XPF/Graphics/ImageKernels.hpp>
 #include <XPF/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 
 
+namespace
+{
+    // Maximum number of threads used by the image operations; atomic because
+    // setThreadCount may be called while other threads process images
+    std::atomic<unsigned int> maxThreadCount(1);
+
+    // Blend a rectangle of pixels over another one
+    class BlendTask : public sf::priv::RowTask
+    {
+    public:
+
+        BlendTask(const sf::Uint8* source, int sourceStride, sf::Uint8* destination, int destinationStride, int width) :
+        m_source           (source),
+        m_sourceStride     (sourceStride),
+        m_destination      (destination),
+        m_destinationStride(destinationStride),
+        m_width            (width)
+        {
+        }
+
+        virtual void process(unsigned int begin, unsigned int end)
+        {
+            for (unsigned int i = begin; i < end; ++i)
+                sf::priv::blendPixels(m_source + i * m_sourceStride, m_destination + i * m_destinationStride, m_width);
+        }
+
+    private:
+
+        const sf::Uint8* m_source;
+        int              m_sourceStride;
+        sf::Uint8*       m_destination;
+        int              m_destinationStride;
+        int              m_width;
+    };
+
+    // Replace the alpha of the pixels matching a color
+    class MaskTask : public sf::priv::RowTask
+    {
+    public:
+
+        MaskTask(sf::Uint8* pixels, unsigned int width, const sf::Color& color, sf::Uint8 alpha) :
+        m_pixels(pixels),
+        m_width (width),
+        m_alpha (alpha)
+        {
+            m_color[0] = color.r;
+            m_color[1] = color.g;
+            m_color[2] = color.b;
+            m_color[3] = color.a;
+        }
+
+        virtual void process(unsigned int begin, unsigned int end)
+        {
+            sf::priv::maskPixels(m_pixels + begin * m_width * 4, (end - begin) * m_width, m_color, m_alpha);
+        }
+
+    private:
+
+        sf::Uint8*   m_pixels;
+        unsigned int m_width;
+        sf::Uint8    m_color[4];
+        sf::Uint8    m_alpha;
+    };
+
+    // Reverse each row of pixels
+    class FlipHorizontallyTask : public sf::priv::RowTask
+    {
+    public:
+
+        FlipHorizontallyTask(sf::Uint8* pixels, unsigned int width) :
+        m_pixels(pixels),
+        m_width (width)
+        {
+        }
+
+        virtual void process(unsigned int begin, unsigned int end)
+        {
+            for (unsigned int i = begin; i < end; ++i)
+                sf::priv::reversePixels(m_pixels + i * m_width * 4, m_width);
+        }
+
+    private:
+
+        sf::Uint8*   m_pixels;
+        unsigned int m_width;
+    };
+
+    // Exchange the rows of the top half with the ones of the bottom half
+    class FlipVerticallyTask : public sf::priv::RowTask
+    {
+    public:
+
+        FlipVerticallyTask(sf::Uint8* pixels, unsigned int width, unsigned int height) :
+        m_pixels(pixels),
+        m_width (width),
+        m_height(height)
+        {
+        }
+
+        virtual void process(unsigned int begin, unsigned int end)
+        {
+            for (unsigned int i = begin; i < end; ++i)
+                sf::priv::swapPixels(m_pixels + i * m_width * 4, m_pixels + (m_height - i - 1) * m_width * 4, m_width);
+        }
+
+    private:
+
+        sf::Uint8*   m_pixels;
+        unsigned int m_width;
+        unsigned int m_height;
+    };
+}
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -172,14 +287,8 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        MaskTask task(&m_pixels[0], m_size.x, color, alpha);
+        priv::processRows(task, m_size.y, m_size.x, maxThreadCount);
     }
 }
 
@@ -229,26 +338,9 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
-        for (int i = 0; i < rows; ++i)
-        {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
-            srcPixels += srcStride;
-            dstPixels += dstStride;
-        }
+        // Interpolation using alpha values, row by row (slower)
+        BlendTask task(srcPixels, srcStride, dstPixels, dstStride, width);
+        priv::processRows(task, rows, width, maxThreadCount);
     }
     else
     {
@@ -302,21 +394,8 @@ void Image::flipHorizontally()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
-
-        for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+        FlipHorizontallyTask task(&m_pixels[0], m_size.x);
+        priv::processRows(task, m_size.y, m_size.x, maxThreadCount);
     }
 }
 
@@ -326,19 +405,16 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
-
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        FlipVerticallyTask task(&m_pixels[0], m_size.x, m_size.y);
+        priv::processRows(task, m_size.y / 2, m_size.x * 2, maxThreadCount);
+    }
+}
 
-        for (std::size_t y = 0; y < m_size.y / 2; ++y)
-        {
-            std::swap_ranges(top, top + rowSize, bottom);
 
-            top += rowSize;
-            bottom -= rowSize;
-        }
-    }
+////////////////////////////////////////////////////////////
+void Image::setThreadCount(unsigned int threadCount)
+{
+    maxThreadCount = threadCount > 0 ? threadCount : 1;
 }
 
 } // namespace sf
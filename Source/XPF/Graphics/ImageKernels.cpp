@@ -0,0 +1,577 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/ImageKernels.hpp>
+#include <XPF/System/Lock.hpp>
+#include <XPF/System/Mutex.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <XPF/System/Thread.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+    #define SFML_IMAGEKERNELS_SSE2
+    #include <emmintrin.h>
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+
+    // Visual C++ only VEX-encodes the 128-bit instructions used next to the 256-bit
+    // ones when the whole project targets AVX (see VertexTransform.cpp)
+    #if defined(__GNUC__) || defined(__AVX2__)
+        #define SFML_IMAGEKERNELS_AVX2
+    #endif
+
+    // GCC and clang only emit SSE2/AVX2 instructions in functions explicitly targeting them
+    #if defined(__GNUC__)
+        #define SFML_TARGET(features) __attribute__((target(features)))
+    #else
+        #define SFML_TARGET(features)
+    #endif
+
+#endif
+
+
+namespace
+{
+    typedef void (*BlendFunction)(const sf::Uint8*, sf::Uint8*, std::size_t);
+    typedef void (*MaskFunction)(sf::Uint8*, std::size_t, const sf::Uint8*, sf::Uint8);
+    typedef void (*ReverseFunction)(sf::Uint8*, std::size_t);
+    typedef void (*SwapFunction)(sf::Uint8*, sf::Uint8*, std::size_t);
+
+    // Images smaller than this are not worth splitting between threads
+    const std::size_t minPixelsPerThread = 128 * 1024;
+
+    // Reference implementations, one pixel at a time (the original sf::Image loops)
+    void blendScalar(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i, src += 4, dst += 4)
+        {
+            sf::Uint8 alpha = src[3];
+            dst[0] = static_cast<sf::Uint8>((src[0] * alpha + dst[0] * (255 - alpha)) / 255);
+            dst[1] = static_cast<sf::Uint8>((src[1] * alpha + dst[1] * (255 - alpha)) / 255);
+            dst[2] = static_cast<sf::Uint8>((src[2] * alpha + dst[2] * (255 - alpha)) / 255);
+            dst[3] = static_cast<sf::Uint8>(alpha + dst[3] * (255 - alpha) / 255);
+        }
+    }
+
+    void maskScalar(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        for (std::size_t i = 0; i < count; ++i, pixels += 4)
+        {
+            if ((pixels[0] == color[0]) && (pixels[1] == color[1]) && (pixels[2] == color[2]) && (pixels[3] == color[3]))
+                pixels[3] = alpha;
+        }
+    }
+
+    void reverseScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        sf::Uint8* left  = pixels;
+        sf::Uint8* right = pixels + (count - 1) * 4;
+        for (std::size_t i = 0; i < count / 2; ++i, left += 4, right -= 4)
+            std::swap_ranges(left, left + 4, right);
+    }
+
+    void swapScalar(sf::Uint8* first, sf::Uint8* second, std::size_t count)
+    {
+        std::swap_ranges(first, first + count * 4, second);
+    }
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+
+    // x / 255, rounded down, for 16-bit lanes in range [0 .. 255 * 255]
+    SFML_TARGET("sse2")
+    inline __m128i divide255(__m128i x)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Blend two pixels widened to 16 bits; the source alpha lane is forced to 255,
+    // so that the same formula gives alpha + dst.a * (255 - alpha) / 255 for it
+    SFML_TARGET("sse2")
+    inline __m128i blendWide(__m128i src, __m128i dst, __m128i alpha)
+    {
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        return divide255(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse)));
+    }
+
+    // Four pixels per iteration
+    SFML_TARGET("sse2")
+    void blendSSE2(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4, src += 16, dst += 16)
+        {
+            __m128i source      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+            __m128i opaque      = _mm_or_si128(source, alphaMask);
+
+            __m128i alphaLow  = _mm_unpacklo_epi8(source, zero);
+            __m128i alphaHigh = _mm_unpackhi_epi8(source, zero);
+            alphaLow  = _mm_shufflehi_epi16(_mm_shufflelo_epi16(alphaLow,  _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alphaHigh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(alphaHigh, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128i low  = blendWide(_mm_unpacklo_epi8(opaque, zero), _mm_unpacklo_epi8(destination, zero), alphaLow);
+            __m128i high = blendWide(_mm_unpackhi_epi8(opaque, zero), _mm_unpackhi_epi8(destination, zero), alphaHigh);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(low, high));
+        }
+        blendScalar(src, dst, count - i);
+    }
+
+    // Four pixels per iteration: a whole pixel is compared as a 32-bit integer
+    SFML_TARGET("sse2")
+    void maskSSE2(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        int key;
+        std::memcpy(&key, color, 4);
+        const __m128i keys      = _mm_set1_epi32(key);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+        const __m128i newAlpha  = _mm_set1_epi32(static_cast<int>(static_cast<unsigned int>(alpha) << 24));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4, pixels += 16)
+        {
+            __m128i values   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+            __m128i selected = _mm_and_si128(_mm_cmpeq_epi32(values, keys), alphaMask);
+            values = _mm_or_si128(_mm_andnot_si128(selected, values), _mm_and_si128(selected, newAlpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), values);
+        }
+        maskScalar(pixels, count - i, color, alpha);
+    }
+
+    // Four pixels from each end per iteration
+    SFML_TARGET("sse2")
+    void reverseSSE2(sf::Uint8* pixels, std::size_t count)
+    {
+        sf::Uint8* left  = pixels;
+        sf::Uint8* right = pixels + count * 4;
+        while (right - left >= 32)
+        {
+            right -= 16;
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+            __m128i last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left),  _mm_shuffle_epi32(last,  _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+            left += 16;
+        }
+        if (right > left)
+            reverseScalar(left, (right - left) / 4);
+    }
+
+    // Sixteen bytes per iteration
+    SFML_TARGET("sse2")
+    void swapSSE2(sf::Uint8* first, sf::Uint8* second, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4, first += 16, second += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(first),  b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(second), a);
+        }
+        swapScalar(first, second, count - i);
+    }
+
+#endif
+
+#ifdef SFML_IMAGEKERNELS_AVX2
+
+    // Same as the SSE2 functions, on 256-bit registers (unpacking and packing both work
+    // within 128-bit halves, so the pixels stay in order)
+    SFML_TARGET("avx2")
+    inline __m256i divide255(__m256i x)
+    {
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    SFML_TARGET("avx2")
+    inline __m256i blendWide(__m256i src, __m256i dst, __m256i alpha)
+    {
+        __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+        return divide255(_mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(dst, inverse)));
+    }
+
+    // Eight pixels per iteration
+    SFML_TARGET("avx2")
+    void blendAVX2(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        const __m256i zero      = _mm256_setzero_si256();
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8, src += 32, dst += 32)
+        {
+            __m256i source      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            __m256i destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+            __m256i opaque      = _mm256_or_si256(source, alphaMask);
+
+            __m256i alphaLow  = _mm256_unpacklo_epi8(source, zero);
+            __m256i alphaHigh = _mm256_unpackhi_epi8(source, zero);
+            alphaLow  = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(alphaLow,  _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alphaHigh = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(alphaHigh, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m256i low  = blendWide(_mm256_unpacklo_epi8(opaque, zero), _mm256_unpacklo_epi8(destination, zero), alphaLow);
+            __m256i high = blendWide(_mm256_unpackhi_epi8(opaque, zero), _mm256_unpackhi_epi8(destination, zero), alphaHigh);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_packus_epi16(low, high));
+        }
+        _mm256_zeroupper();
+        blendScalar(src, dst, count - i);
+    }
+
+    // Eight pixels per iteration
+    SFML_TARGET("avx2")
+    void maskAVX2(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        int key;
+        std::memcpy(&key, color, 4);
+        const __m256i keys      = _mm256_set1_epi32(key);
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+        const __m256i newAlpha  = _mm256_set1_epi32(static_cast<int>(static_cast<unsigned int>(alpha) << 24));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8, pixels += 32)
+        {
+            __m256i values   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels));
+            __m256i selected = _mm256_and_si256(_mm256_cmpeq_epi32(values, keys), alphaMask);
+            values = _mm256_or_si256(_mm256_andnot_si256(selected, values), _mm256_and_si256(selected, newAlpha));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels), values);
+        }
+        _mm256_zeroupper();
+        maskScalar(pixels, count - i, color, alpha);
+    }
+
+    // Eight pixels from each end per iteration
+    SFML_TARGET("avx2")
+    void reverseAVX2(sf::Uint8* pixels, std::size_t count)
+    {
+        const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+        sf::Uint8* left  = pixels;
+        sf::Uint8* right = pixels + count * 4;
+        while (right - left >= 64)
+        {
+            right -= 32;
+            __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left));
+            __m256i last  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left),  _mm256_permutevar8x32_epi32(last,  reversed));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right), _mm256_permutevar8x32_epi32(first, reversed));
+            left += 32;
+        }
+        _mm256_zeroupper();
+        if (right > left)
+            reverseScalar(left, (right - left) / 4);
+    }
+
+    // Thirty-two bytes per iteration
+    SFML_TARGET("avx2")
+    void swapAVX2(sf::Uint8* first, sf::Uint8* second, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8, first += 32, second += 32)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(first),  b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(second), a);
+        }
+        _mm256_zeroupper();
+        swapScalar(first, second, count - i);
+    }
+
+#endif
+
+#ifdef SFML_IMAGEKERNELS_SSE2
+
+    // Query the CPU features (function 'leaf', sub-function 0)
+    void cpuid(unsigned int info[4], unsigned int leaf)
+    {
+    #if defined(_MSC_VER)
+        int registers[4];
+        __cpuidex(registers, static_cast<int>(leaf), 0);
+        for (int i = 0; i < 4; ++i)
+            info[i] = static_cast<unsigned int>(registers[i]);
+    #else
+        __cpuid_count(leaf, 0, info[0], info[1], info[2], info[3]);
+    #endif
+    }
+
+#endif
+
+#ifdef SFML_IMAGEKERNELS_AVX2
+
+    // Check whether the CPU and the OS both support AVX2
+    bool isAvx2Supported()
+    {
+        unsigned int info[4];
+        cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        cpuid(info, 1);
+        if (((info[2] & (1 << 27)) == 0) || ((info[2] & (1 << 28)) == 0))
+            return false;
+
+        // The OS must save the AVX registers on context switches
+    #if defined(_MSC_VER)
+        if ((_xgetbv(0) & 6) != 6)
+            return false;
+    #else
+        unsigned int eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        if ((eax & 6) != 6)
+            return false;
+    #endif
+
+        cpuid(info, 7);
+        return (info[1] & (1 << 5)) != 0;
+    }
+
+#endif
+
+    // Set of implementations of the kernels
+    struct Kernels
+    {
+        BlendFunction   blend;
+        MaskFunction    mask;
+        ReverseFunction reverse;
+        SwapFunction    swap;
+    };
+
+    // Select the fastest implementations supported by the CPU
+    Kernels selectKernels()
+    {
+    #ifdef SFML_IMAGEKERNELS_AVX2
+        if (isAvx2Supported())
+        {
+            Kernels kernels = {&blendAVX2, &maskAVX2, &reverseAVX2, &swapAVX2};
+            return kernels;
+        }
+    #endif
+
+    #ifdef SFML_IMAGEKERNELS_SSE2
+        unsigned int info[4];
+        cpuid(info, 1);
+        if (info[3] & (1 << 26))
+        {
+            Kernels kernels = {&blendSSE2, &maskSSE2, &reverseSSE2, &swapSSE2};
+            return kernels;
+        }
+    #endif
+
+        Kernels kernels = {&blendScalar, &maskScalar, &reverseScalar, &swapScalar};
+        return kernels;
+    }
+
+    // Implementations used by the kernel functions, selected on first use rather
+    // than at static initialization time, so that static initializers of other
+    // translation units can use them
+    const Kernels& getKernels()
+    {
+        static const Kernels kernels = selectKernels();
+        return kernels;
+    }
+
+    // Range of rows processed by a worker thread, and the count of unfinished
+    // bands of the processRows call it belongs to
+    struct RowBand
+    {
+        RowBand(sf::priv::RowTask& task, unsigned int begin, unsigned int end, std::size_t& remaining) :
+        task(&task), begin(begin), end(end), remaining(&remaining) {}
+
+        sf::priv::RowTask* task;
+        unsigned int       begin;
+        unsigned int       end;
+        std::size_t*       remaining;
+    };
+
+    // Worker threads shared by all the images, sleeping on a condition variable
+    // between two calls to processRows
+    class RowWorkerPool : sf::NonCopyable
+    {
+    public:
+
+        RowWorkerPool() :
+        m_workers (),
+        m_bands   (),
+        m_mutex   (),
+        m_pending (),
+        m_finished()
+        {
+        }
+
+        // Process the bands, the first one in the calling thread and the others
+        // in the workers, and wait until they are all done
+        void process(const std::vector<RowBand>& bands)
+        {
+            std::size_t& remaining = *bands[0].remaining;
+
+            {
+                sf::Lock lock(m_mutex);
+
+                remaining = bands.size() - 1;
+
+                // Start the workers on first use, and add more if a larger thread count is requested
+                while (m_workers.size() < remaining)
+                {
+                    m_workers.push_back(new sf::Thread(&RowWorkerPool::run, this));
+                    m_workers.back()->launch();
+                }
+
+                m_bands.insert(m_bands.end(), bands.begin() + 1, bands.end());
+            }
+            m_pending.notify_all();
+
+            bands[0].task->process(bands[0].begin, bands[0].end);
+
+            sf::Lock lock(m_mutex);
+            while (remaining > 0)
+                m_finished.wait(m_mutex);
+        }
+
+    private:
+
+        void run()
+        {
+            for (;;)
+            {
+                RowBand band = takeBand();
+                band.task->process(band.begin, band.end);
+
+                {
+                    sf::Lock lock(m_mutex);
+                    --*band.remaining;
+                }
+                m_finished.notify_all();
+            }
+        }
+
+        RowBand takeBand()
+        {
+            sf::Lock lock(m_mutex);
+
+            while (m_bands.empty())
+                m_pending.wait(m_mutex);
+
+            RowBand band = m_bands.front();
+            m_bands.pop_front();
+
+            return band;
+        }
+
+        std::vector<sf::Thread*>    m_workers;  // Worker threads, never stopped
+        std::deque<RowBand>         m_bands;    // Bands waiting for a worker
+        sf::Mutex                   m_mutex;    // Mutex protecting the queue and the band counters
+        std::condition_variable_any m_pending;  // Condition the idle workers wait on
+        std::condition_variable_any m_finished; // Condition signaled when a worker finishes a band
+    };
+
+    // The pool is started on first use and deliberately never destroyed: joining
+    // threads from a static destructor can deadlock when the module is unloaded,
+    // and the sleeping workers are terminated with the process anyway
+    RowWorkerPool& getRowWorkerPool()
+    {
+        static RowWorkerPool* pool = new RowWorkerPool;
+        return *pool;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count)
+{
+    getKernels().blend(source, destination, count);
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha)
+{
+    getKernels().mask(pixels, count, color, alpha);
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    if (count > 1)
+        getKernels().reverse(pixels, count);
+}
+
+
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count)
+{
+    getKernels().swap(first, second, count);
+}
+
+
+////////////////////////////////////////////////////////////
+void processRows(RowTask& task, unsigned int rows, std::size_t pixelsPerRow, unsigned int threadCount)
+{
+    // Use as many threads as the size of the image justifies
+    std::size_t bands = std::min<std::size_t>(threadCount, rows);
+    bands = std::min(bands, rows * pixelsPerRow / minPixelsPerThread);
+
+    if (bands <= 1)
+    {
+        task.process(0, rows);
+        return;
+    }
+
+    // The first band is processed by the calling thread, the others by the shared workers
+    std::size_t remaining = 0;
+    std::vector<RowBand> rowBands;
+    for (std::size_t i = 0; i < bands; ++i)
+    {
+        unsigned int begin = static_cast<unsigned int>(rows * i / bands);
+        unsigned int end   = static_cast<unsigned int>(rows * (i + 1) / bands);
+        rowBands.push_back(RowBand(task, begin, end, remaining));
+    }
+
+    getRowWorkerPool().process(rowBands);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend RGBA pixels over others, using the source alpha
+///
+/// The result is the same as sf::Image::copy with applyAlpha
+/// (integer interpolation, rounded down). The implementation
+/// (scalar, SSE2 or AVX2) is selected on first use from the
+/// features of the CPU, as for all the functions of this file.
+///
+/// \param source      Pixels to blend
+/// \param destination Pixels to blend over, receiving the result
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the RGBA pixels that match a color
+///
+/// \param pixels Pixels to process
+/// \param count  Number of pixels
+/// \param color  Color to match (4 components, in RGBA order)
+/// \param alpha  Alpha given to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of an array of RGBA pixels, in place
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange two non-overlapping arrays of RGBA pixels
+///
+/// \param first  First array
+/// \param second Second array
+/// \param count  Number of pixels in each array
+///
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Operation applied to ranges of rows of an image
+///
+////////////////////////////////////////////////////////////
+class RowTask
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~RowTask() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a range of rows
+    ///
+    /// This function may be called concurrently for disjoint
+    /// ranges.
+    ///
+    /// \param begin First row to process
+    /// \param end   Row after the last one to process
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(unsigned int begin, unsigned int end) = 0;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Process all the rows of an image, in parallel if it is large enough
+///
+/// Small images, and images processed with a thread count
+/// of 1, are processed directly in the calling thread.
+///
+/// \param task         Operation to apply
+/// \param rows         Number of rows
+/// \param pixelsPerRow Number of pixels processed in each row
+/// \param threadCount  Maximum number of threads to use, including the calling one
+///
+////////////////////////////////////////////////////////////
+void processRows(RowTask& task, unsigned int rows, std::size_t pixelsPerRow, unsigned int threadCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/ImageReadback.hpp>
+#include <XPF/Graphics/GLCheck.hpp>
+#include <vector>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageReadback::ImageReadback() :
+m_buffer    (0),
+m_fence     (NULL),
+m_size      (0, 0),
+m_sourceSize(0, 0),
+m_flipped   (false),
+m_pending   (false),
+m_image     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageReadback::~ImageReadback()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_buffer || m_fence)
+    {
+        ensureGlContext();
+
+        deleteFence();
+
+        if (m_buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(m_buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageReadback::isPending() const
+{
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageReadback::isReady() const
+{
+    if (!m_pending)
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_fence)
+    {
+        ensureGlContext();
+
+        // A zero timeout only queries the status of the fence
+        GLenum status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), 0, 0);
+        return (status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED);
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Without fences we can't know, mapping the buffer will wait if needed
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageReadback::getImage(Image& image)
+{
+    if (!m_pending)
+        return false;
+
+    m_pending = false;
+
+    // Synchronous copy: the image is already there
+    if (!m_buffer)
+    {
+        image = m_image;
+        m_image = Image();
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    deleteFence();
+
+    // Mapping the buffer waits for the copy if it is not complete yet
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+    const Uint8* src = static_cast<const Uint8*>(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY));
+    if (src)
+    {
+        if ((m_size == m_sourceSize) && !m_flipped)
+        {
+            // Pixels are not padded nor flipped, we can use a direct copy
+            image.create(m_size.x, m_size.y, src);
+        }
+        else
+        {
+            // Copy the useful rows, in the right order
+            std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
+            Uint8* dst = &pixels[0];
+            int srcPitch = m_sourceSize.x * 4;
+            int dstPitch = m_size.x * 4;
+
+            if (m_flipped)
+            {
+                src += srcPitch * (m_size.y - 1);
+                srcPitch = -srcPitch;
+            }
+
+            for (unsigned int i = 0; i < m_size.y; ++i)
+            {
+                std::memcpy(dst, src, dstPitch);
+                src += srcPitch;
+                dst += dstPitch;
+            }
+
+            image.create(m_size.x, m_size.y, &pixels[0]);
+        }
+
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+    }
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    return src != NULL;
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageReadback::isAvailable()
+{
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_pixel_buffer_object && GLEXT_vertex_buffer_object;
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageReadback::beginRead(const Vector2u& size, const Vector2u& sourceSize, bool flipped)
+{
+#ifndef SFML_OPENGL_ES
+
+    // A copy that was never retrieved is dropped
+    deleteFence();
+    m_image = Image();
+
+    m_size       = size;
+    m_sourceSize = sourceSize;
+    m_flipped    = flipped;
+
+    if (!m_buffer)
+    {
+        GLuint buffer;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    // Reallocating the storage every time lets the driver orphan the previous one
+    // instead of waiting until the GPU stops using it
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, sourceSize.x * sourceSize.y * 4, NULL, GLEXT_GL_STREAM_READ));
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageReadback::endRead()
+{
+#ifndef SFML_OPENGL_ES
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    if (GLEXT_sync)
+        m_fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Make sure that the copy (and the fence) are submitted, so that the fence
+    // can be polled from any context
+    glCheck(glFlush());
+
+    m_pending = true;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageReadback::setImage(const Image& image)
+{
+    m_image   = image;
+    m_pending = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageReadback::deleteFence()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_fence)
+    {
+        GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence));
+        m_fence = NULL;
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace sf
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/RenderQueue.hpp>
+#include <XPF/Graphics/RenderTarget.hpp>
+#include <XPF/Graphics/VertexArray.hpp>
+#include <XPF/System/Lock.hpp>
+#include <algorithm>
+#include <map>
+
+
+namespace
+{
+    // Bits of the sort key, from the most significant to the least significant:
+    // layer (16), shader (12), texture (20), blending mode (12), primitive type (4)
+    const sf::Uint64 maxShaderSlot    = (1 << 12) - 1;
+    const sf::Uint64 maxTextureSlot   = (1 << 20) - 1;
+    const sf::Uint64 maxBlendModeSlot = (1 << 12) - 1;
+
+    // Entry of the sorted command list
+    struct SortEntry
+    {
+        sf::Uint64  key;
+        float       depth;
+        std::size_t command;
+    };
+
+    // Sort entries by key, then by depth
+    struct KeyOrder
+    {
+        bool operator ()(const SortEntry& left, const SortEntry& right) const
+        {
+            if (left.key != right.key)
+                return left.key < right.key;
+
+            return left.depth < right.depth;
+        }
+    };
+
+    // Give a small number to each distinct state, in order of first use
+    template <typename T>
+    sf::Uint64 getSlot(std::map<T, sf::Uint64>& slots, const T& state, sf::Uint64 maxSlot)
+    {
+        typename std::map<T, sf::Uint64>::iterator it = slots.find(state);
+        if (it != slots.end())
+            return it->second;
+
+        // Slots that don't fit in the key are shared; the key only drives the order,
+        // states are still compared for real when building the batches
+        sf::Uint64 slot = std::min(static_cast<sf::Uint64>(slots.size()), maxSlot);
+        slots.insert(std::make_pair(state, slot));
+
+        return slot;
+    }
+
+    sf::Uint64 getBlendModeSlot(std::vector<sf::BlendMode>& slots, const sf::BlendMode& blendMode, sf::Uint64 maxSlot)
+    {
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            if (slots[i] == blendMode)
+                return std::min(static_cast<sf::Uint64>(i), maxSlot);
+        }
+
+        slots.push_back(blendMode);
+
+        return std::min(static_cast<sf::Uint64>(slots.size() - 1), maxSlot);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue() :
+m_needSort(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states, int layer, float depth)
+{
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Lock lock(m_mutex);
+
+    Command command;
+    command.texture   = states.texture;
+    command.shader    = states.shader;
+    command.blendMode = states.blendMode;
+    command.layer     = std::max(-32768, std::min(layer, 32767));
+    command.depth     = depth;
+    command.first     = m_vertices.size();
+
+    // Convert connected primitives to lists, so that commands can be merged
+    switch (type)
+    {
+        case LinesStrip:
+        {
+            command.type = Lines;
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                m_vertices.push_back(vertices[i - 1]);
+                m_vertices.push_back(vertices[i]);
+            }
+            break;
+        }
+
+        case TrianglesStrip:
+        {
+            command.type = Triangles;
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                m_vertices.push_back(vertices[i - 2]);
+                m_vertices.push_back(vertices[i - 1]);
+                m_vertices.push_back(vertices[i]);
+            }
+            break;
+        }
+
+        case TrianglesFan:
+        {
+            command.type = Triangles;
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                m_vertices.push_back(vertices[0]);
+                m_vertices.push_back(vertices[i - 1]);
+                m_vertices.push_back(vertices[i]);
+            }
+            break;
+        }
+
+        default:
+        {
+            command.type = type;
+            m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+            break;
+        }
+    }
+
+    command.count = m_vertices.size() - command.first;
+    if (command.count == 0)
+        return;
+
+    // Apply the transform now, so that commands with different transforms can be merged
+    states.transform.transformVertices(&m_vertices[command.first], &m_vertices[command.first], command.count);
+
+    m_commands.push_back(command);
+    m_needSort = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(const VertexArray& vertices, const RenderStates& states, int layer, float depth)
+{
+    if (vertices.getVertexCount() > 0)
+        draw(&vertices[0], vertices.getVertexCount(), vertices.getPrimitiveType(), states, layer, depth);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::append(const RenderQueue& queue)
+{
+    if (&queue == this)
+        return;
+
+    Lock lock(m_mutex);
+    Lock otherLock(queue.m_mutex);
+
+    std::size_t offset = m_vertices.size();
+    m_vertices.insert(m_vertices.end(), queue.m_vertices.begin(), queue.m_vertices.end());
+
+    for (std::vector<Command>::const_iterator it = queue.m_commands.begin(); it != queue.m_commands.end(); ++it)
+    {
+        m_commands.push_back(*it);
+        m_commands.back().first += offset;
+    }
+
+    if (!queue.m_commands.empty())
+        m_needSort = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::clear()
+{
+    Lock lock(m_mutex);
+
+    m_vertices.clear();
+    m_commands.clear();
+    m_sortedVertices.clear();
+    m_batches.clear();
+    m_needSort = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getCommandCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getBatchCount() const
+{
+    ensureSorted();
+
+    return m_batches.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureSorted();
+
+    for (std::vector<Batch>::const_iterator it = m_batches.begin(); it != m_batches.end(); ++it)
+    {
+        states.texture   = it->texture;
+        states.shader    = it->shader;
+        states.blendMode = it->blendMode;
+        target.draw(&m_sortedVertices[it->first], it->count, it->type, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::ensureSorted() const
+{
+    Lock lock(m_mutex);
+
+    if (!m_needSort)
+        return;
+
+    // Build the sort key of each command
+    std::map<const Shader*, Uint64> shaderSlots;
+    std::map<const Texture*, Uint64> textureSlots;
+    std::vector<BlendMode> blendModeSlots;
+
+    std::vector<SortEntry> entries(m_commands.size());
+    for (std::size_t i = 0; i < m_commands.size(); ++i)
+    {
+        const Command& command = m_commands[i];
+
+        Uint64 layer = static_cast<Uint64>(command.layer + 32768);
+        Uint64 shader = getSlot(shaderSlots, command.shader, maxShaderSlot);
+        Uint64 texture = getSlot(textureSlots, command.texture, maxTextureSlot);
+        Uint64 blendMode = getBlendModeSlot(blendModeSlots, command.blendMode, maxBlendModeSlot);
+
+        entries[i].key     = (layer << 48) | (shader << 36) | (texture << 16) | (blendMode << 4) | static_cast<Uint64>(command.type);
+        entries[i].depth   = command.depth;
+        entries[i].command = i;
+    }
+
+    // Sort them; commands with equal keys keep their recording order
+    std::stable_sort(entries.begin(), entries.end(), KeyOrder());
+
+    // Copy the vertices in drawing order, and merge consecutive commands with the same states
+    m_sortedVertices.resize(m_vertices.size());
+    m_batches.clear();
+
+    std::size_t count = 0;
+    for (std::vector<SortEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        const Command& command = m_commands[it->command];
+        std::copy(m_vertices.begin() + command.first, m_vertices.begin() + command.first + command.count, m_sortedVertices.begin() + count);
+
+        if (!m_batches.empty() &&
+            (m_batches.back().texture == command.texture) &&
+            (m_batches.back().shader == command.shader) &&
+            (m_batches.back().blendMode == command.blendMode) &&
+            (m_batches.back().type == command.type))
+        {
+            m_batches.back().count += command.count;
+        }
+        else
+        {
+            Batch batch;
+            batch.texture   = command.texture;
+            batch.shader    = command.shader;
+            batch.blendMode = command.blendMode;
+            batch.type      = command.type;
+            batch.first     = count;
+            batch.count     = command.count;
+            m_batches.push_back(batch);
+        }
+
+        count += command.count;
+    }
+
+    m_needSort = false;
+}
+
+} // namespace sf
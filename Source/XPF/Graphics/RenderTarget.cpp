@@ -30,8 +30,11 @@
 #include <XPF/Graphics/Shader.hpp>
 #include <XPF/Graphics/Texture.hpp>
 #include <XPF/Graphics/VertexArray.hpp>
+#include <XPF/Graphics/VertexBuffer.hpp>
 #include <XPF/Graphics/GLCheck.hpp>
+#include <XPF/Graphics/ShaderPipeline.hpp>
 #include <XPF/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -82,23 +85,47 @@ namespace sf
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
-m_cache      ()
+m_cache      (),
+m_pipeline   (NULL)
 {
     m_cache.glStatesSet = false;
+    m_cache.batching = false;
+    m_cache.batchTexture = NULL;
+    m_cache.batchTextureId = 0;
+    m_cache.batchShader = NULL;
+    m_cache.batchCount = 0;
+    m_cache.lastBatchCount = 0;
+    m_cache.culling = false;
+    m_cache.gpuTiming = false;
+    m_cache.gpuQueries[0] = 0;
+    m_cache.gpuQueries[1] = 0;
+    m_cache.gpuQuery = 0;
+    m_cache.gpuQueryActive = false;
+    m_cache.gpuQueryPending[0] = false;
+    m_cache.gpuQueryPending[1] = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    // The timer queries are not deleted here: the context of the target
+    // can't be activated from this destructor, and they are destroyed
+    // along with it anyway
+    delete m_pipeline;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Render the pending batch before it gets overwritten
+    flush();
+
     if (activate(true))
     {
+        beginGpuTimer();
+
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
@@ -111,8 +138,12 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // The pending batch must be rendered with the previous view
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
+    updateViewBounds();
 }
 
 
@@ -203,7 +234,7 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
-    // GL_QUADS is unavailable on OpenGL ES
+    // GL_QUADS is unavailable on OpenGL ES (the programmable pipeline converts them)
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
         {
@@ -213,50 +244,102 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         #define GL_QUADS 0
     #endif
 
-    if (activate(true))
+    if (m_cache.batching)
     {
-        // First set the persistent OpenGL states if it's the very first call
-        if (!m_cache.glStatesSet)
-            resetGLStates();
+        // Connected primitives are converted to lists, so that they can be merged
+        PrimitiveType batchType = type;
+        if (type == LinesStrip)
+            batchType = Lines;
+        else if ((type == TrianglesStrip) || (type == TrianglesFan))
+            batchType = Triangles;
 
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
-        if (useVertexCache)
+        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+
+        // Start a new batch if the render states are not compatible with the pending one
+        if (!m_cache.batchVertices.empty() &&
+            ((batchType != m_cache.batchType) ||
+             (states.blendMode != m_cache.batchBlendMode) ||
+             (textureId != m_cache.batchTextureId) ||
+             (states.shader != m_cache.batchShader)))
         {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            flush();
+        }
 
-            // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
+        if (m_cache.batchVertices.empty())
+        {
+            m_cache.batchType      = batchType;
+            m_cache.batchBlendMode = states.blendMode;
+            m_cache.batchTexture   = states.texture;
+            m_cache.batchTextureId = textureId;
+            m_cache.batchShader    = states.shader;
         }
-        else
+
+        std::vector<Vertex>& batch = m_cache.batchVertices;
+        std::size_t offset = batch.size();
+
+        switch (type)
         {
-            applyTransform(states.transform);
+            case LinesStrip:
+            {
+                for (std::size_t i = 1; i < vertexCount; ++i)
+                {
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case TrianglesStrip:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    batch.push_back(vertices[i - 2]);
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case TrianglesFan:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    batch.push_back(vertices[0]);
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            default:
+            {
+                batch.insert(batch.end(), vertices, vertices + vertexCount);
+                break;
+            }
         }
 
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
+        // Pre-transform the appended vertices
+        if (batch.size() > offset)
+            states.transform.transformVertices(&batch[offset], &batch[offset], batch.size() - offset);
 
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
+        return;
+    }
 
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
+    if (activate(true))
+    {
+        // Check if the vertex count is low enough so that we can pre-transform them
+        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+        if (useVertexCache)
+        {
+            // Pre-transform the vertices and store them into the vertex cache
+            states.transform.transformVertices(vertices, m_cache.vertexCache, vertexCount);
+        }
 
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
+        setupDraw(useVertexCache, states);
+
+        // The programmable pipeline streams the vertices to its own buffer
+        if (m_pipeline)
+            m_pipeline->setVertices(useVertexCache ? m_cache.vertexCache : vertices, vertexCount, type);
 
         // If we pre-transform the vertices, we must use our internal vertex cache
         if (useVertexCache)
@@ -269,7 +352,7 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
 
         // Setup the pointers to the vertices' components
-        if (vertices)
+        if (vertices && !m_pipeline)
         {
             const char* data = reinterpret_cast<const char*>(vertices);
             glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
@@ -277,22 +360,9 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
         }
 
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
-
-        // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
-
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
+        drawPrimitives(type, 0, vertexCount);
 
-        // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
-        // This prevents a bug where some drivers do not clear RenderTextures properly.
-        if (states.texture && states.texture->m_fboAttachment)
-            applyTexture(NULL);
+        cleanupDraw(states);
 
         // Update the cache
         m_cache.useVertexCache = useVertexCache;
@@ -300,9 +370,203 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount || !vertexBuffer.getNativeHandle())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Keep the drawing order consistent
+    flush();
+
+    if (activate(true))
+    {
+        setupDraw(false, states);
+
+        // The transform and the vertex pointers of the vertex cache are replaced by
+        // those of the buffer, they must be set again the next time the cache is used
+        m_cache.useVertexCache = false;
+
+        if (m_pipeline)
+        {
+            // Quads can only be converted when they are streamed
+            if (vertexBuffer.getPrimitiveType() == Quads)
+            {
+                err() << "sf::Quads primitive type is not supported by core profile contexts, drawing skipped" << std::endl;
+                cleanupDraw(states);
+                return;
+            }
+
+            m_pipeline->setVertexBuffer(vertexBuffer.getNativeHandle());
+            drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+            cleanupDraw(states);
+            return;
+        }
+
+        // Bind the vertex buffer and setup the pointers to the vertices' components,
+        // which are now offsets into the buffer
+        VertexBuffer::bind(&vertexBuffer);
+
+        const char* data = NULL;
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+
+        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+
+        // Unbind the vertex buffer so that client-side arrays work again
+        VertexBuffer::bind(NULL);
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    // Don't lose the pending batch
+    if (!enabled)
+        flush();
+
+    m_cache.batching = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_cache.batching;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (!m_cache.batching || m_cache.batchVertices.empty())
+        return;
+
+    // The vertices are already transformed, they must be rendered with an identity transform
+    RenderStates states(m_cache.batchBlendMode, Transform::Identity, m_cache.batchTexture, m_cache.batchShader);
+
+    // Disable batching while the batch is submitted, so that draw() goes
+    // straight to OpenGL (and so that nested calls to flush() do nothing)
+    m_cache.batching = false;
+    draw(&m_cache.batchVertices[0], m_cache.batchVertices.size(), m_cache.batchType, states);
+    m_cache.batching = true;
+
+    // Keep the storage allocated for the next batches
+    m_cache.batchVertices.clear();
+    m_cache.batchTexture = NULL;
+    m_cache.batchShader = NULL;
+    m_cache.batchCount++;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTarget::getBatchCount() const
+{
+    return m_cache.lastBatchCount;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStatistics& RenderTarget::getStatistics() const
+{
+    return m_cache.lastStatistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setGpuTimingEnabled(bool enabled)
+{
+    // Stop the measure of the current frame, it will never be read
+    if (!enabled && m_cache.gpuQueryActive && activate(true))
+    {
+#ifndef SFML_OPENGL_ES
+        glCheck(GLEXT_glEndQuery(GLEXT_GL_TIME_ELAPSED));
+#endif
+        m_cache.gpuQueryActive = false;
+    }
+
+    m_cache.gpuTiming = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isGpuTimingEnabled() const
+{
+    return m_cache.gpuTiming;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCullingEnabled(bool enabled)
+{
+    m_cache.culling = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCullingEnabled() const
+{
+    return m_cache.culling;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCulled(const FloatRect& bounds, const Transform& transform) const
+{
+    if (!m_cache.culling)
+        return false;
+
+    // Flat rectangles (lines, points) must not be culled because of their size
+    FloatRect worldBounds = transform.transformRect(bounds);
+
+    return (worldBounds.left > m_cache.viewBounds.left + m_cache.viewBounds.width)  ||
+           (worldBounds.top  > m_cache.viewBounds.top + m_cache.viewBounds.height)  ||
+           (worldBounds.left + worldBounds.width < m_cache.viewBounds.left)         ||
+           (worldBounds.top + worldBounds.height < m_cache.viewBounds.top);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    flush();
+
     if (activate(true))
     {
         #ifdef SFML_DEBUG
@@ -316,16 +580,20 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        // Attribute and matrix stacks don't exist in core profiles
+        if (!m_pipeline)
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
     }
 
     resetGLStates();
@@ -335,7 +603,9 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
-    if (activate(true))
+    flush();
+
+    if (activate(true) && !m_pipeline)
     {
         glCheck(glMatrixMode(GL_PROJECTION));
         glCheck(glPopMatrix());
@@ -354,6 +624,9 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    // Render the pending batch with the states it was recorded with
+    flush();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable = Shader::isAvailable();
 
@@ -362,31 +635,46 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // Core profiles have no fixed-function pipeline, use the programmable one
+        if (!m_pipeline && priv::ShaderPipeline::isRequired())
+        {
+            m_pipeline = new priv::ShaderPipeline;
+            if (!m_pipeline->create())
+            {
+                delete m_pipeline;
+                m_pipeline = NULL;
+            }
+        }
+
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            if (!m_pipeline)
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
         }
 
         // Define the default OpenGL states
         glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
         glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        if (!m_pipeline)
+        {
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
         applyTexture(NULL);
-        if (shaderAvailable)
+        if (shaderAvailable || m_pipeline)
             applyShader(NULL);
 
         m_cache.useVertexCache = false;
@@ -403,12 +691,28 @@ void RenderTarget::initialize()
     // Setup the default and current views
     m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
     m_view = m_defaultView;
+    updateViewBounds();
 
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::endFrame()
+{
+    flush();
+
+    m_cache.lastBatchCount = m_cache.batchCount;
+    m_cache.batchCount = 0;
+
+    // Publish the statistics of the frame
+    endGpuTimer();
+    m_cache.lastStatistics = m_cache.statistics;
+    m_cache.statistics = RenderStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -418,13 +722,92 @@ void RenderTarget::applyCurrentView()
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
     // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    if (m_pipeline)
+    {
+        m_pipeline->setProjection(m_view.getTransform().getMatrix());
+    }
+    else
+    {
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
 
     m_cache.viewChanged = false;
+    m_cache.statistics.viewChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::updateViewBounds()
+{
+    // The inverse transform maps the clip space square to the (possibly rotated) view area
+    m_cache.viewBounds = m_view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::beginGpuTimer()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_cache.gpuTiming || m_cache.gpuQueryActive)
+        return;
+
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_timer_query)
+        return;
+
+    // Queries belong to the context of the target, create them on first use
+    if (!m_cache.gpuQueries[0])
+    {
+        GLuint queries[2] = {0, 0};
+        glCheck(GLEXT_glGenQueries(2, queries));
+        m_cache.gpuQueries[0] = static_cast<unsigned int>(queries[0]);
+        m_cache.gpuQueries[1] = static_cast<unsigned int>(queries[1]);
+    }
+
+    // If the result of this query was never available, it is lost now
+    glCheck(GLEXT_glBeginQuery(GLEXT_GL_TIME_ELAPSED, m_cache.gpuQueries[m_cache.gpuQuery]));
+    m_cache.gpuQueryActive = true;
+    m_cache.gpuQueryPending[m_cache.gpuQuery] = false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endGpuTimer()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_cache.gpuQueryActive || !activate(true))
+        return;
+
+    glCheck(GLEXT_glEndQuery(GLEXT_GL_TIME_ELAPSED));
+    m_cache.gpuQueryActive = false;
+    m_cache.gpuQueryPending[m_cache.gpuQuery] = true;
+
+    // Read the previous frame's query, only if it doesn't have to wait for the graphics card
+    m_cache.gpuQuery = 1 - m_cache.gpuQuery;
+    if (m_cache.gpuQueryPending[m_cache.gpuQuery])
+    {
+        GLint available = GL_FALSE;
+        glCheck(GLEXT_glGetQueryObjectiv(m_cache.gpuQueries[m_cache.gpuQuery], GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+        if (available)
+        {
+            GLEXT_GLuint64 nanoseconds = 0;
+            glCheck(GLEXT_glGetQueryObjectui64v(m_cache.gpuQueries[m_cache.gpuQuery], GLEXT_GL_QUERY_RESULT, &nanoseconds));
+            m_cache.statistics.gpuTime = microseconds(static_cast<Int64>(nanoseconds / 1000));
+            m_cache.statistics.gpuTimeAvailable = true;
+            m_cache.gpuQueryPending[m_cache.gpuQuery] = false;
+        }
+    }
+
+#endif
 }
 
 
@@ -473,12 +856,19 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     }
 
     m_cache.lastBlendMode = mode;
+    m_cache.statistics.blendModeChanges++;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+    if (m_pipeline)
+    {
+        m_pipeline->setModelView(transform.getMatrix());
+        return;
+    }
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
     glCheck(glLoadMatrixf(transform.getMatrix()));
@@ -488,16 +878,106 @@ void RenderTarget::applyTransform(const Transform& transform)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    // The texture matrix doesn't exist in core profiles, the pipeline converts the coordinates
+    if (m_pipeline)
+        m_pipeline->setTexture(texture);
+    else
+        Texture::bind(texture, Texture::Pixels);
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    m_cache.statistics.textureBinds++;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
-    Shader::bind(shader);
+    // Shader::bind relies on the texture matrix, which core profiles lack:
+    // the programmable pipeline binds the shader and its textures itself
+    if (m_pipeline)
+        m_pipeline->setShader(shader);
+    else
+        Shader::bind(shader);
+
+    if (shader)
+        m_cache.statistics.shaderBinds++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+{
+    // First set the persistent OpenGL states if it's the very first call
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    // Start measuring the frame on the graphics card
+    beginGpuTimer();
+
+    if (useVertexCache)
+    {
+        // Since vertices are transformed, we must use an identity transform to render them
+        if (!m_cache.useVertexCache)
+            applyTransform(Transform::Identity);
+    }
+    else
+    {
+        applyTransform(states.transform);
+    }
+
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (textureId != m_cache.lastTextureId)
+        applyTexture(states.texture);
+
+    // Apply the shader
+    if (states.shader)
+        applyShader(states.shader);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    if (m_pipeline)
+    {
+        m_pipeline->draw(type, firstVertex, vertexCount);
+    }
+    else
+    {
+        // Find the OpenGL primitive type
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+        GLenum mode = modes[type];
+
+        // Draw the primitives
+        glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+    }
+
+    m_cache.statistics.drawCalls++;
+    m_cache.statistics.vertices += vertexCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupDraw(const RenderStates& states)
+{
+    // Unbind the shader, if any
+    if (states.shader)
+        applyShader(NULL);
+
+    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
+    // This prevents a bug where some drivers do not clear RenderTextures properly.
+    if (states.texture && states.texture->m_fboAttachment)
+        applyTexture(NULL);
 }
 
 } // namespace sf
@@ -538,4 +1018,21 @@ void RenderTarget::applyShader(const Shader* shader)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Programmable pipeline
+//   Core profile contexts have no fixed-function pipeline: the
+//   view, transform and texture matrices become uniforms of a
+//   built-in shader, and vertices are streamed to an orphaned
+//   vertex buffer (quads being split into triangles). Uniforms
+//   are only uploaded when they changed since the last draw.
+//
+// * Batching (optional)
+//   When enabled, the vertex cache idea is pushed further:
+//   vertices of consecutive draws sharing the same texture,
+//   blend mode, shader and primitive type are pre-transformed
+//   into a growing vertex stream, which is rendered with a
+//   single draw call when the states change, the view changes,
+//   the target is cleared or the frame ends. Since shader
+//   parameters and texture contents can't be tracked, users
+//   must flush() explicitly before changing them mid-frame.
+//
 ////////////////////////////////////////////////////////////
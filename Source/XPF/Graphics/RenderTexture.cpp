@@ -126,6 +126,9 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Render the pending batch, it must be part of the texture
+    RenderTarget::endFrame();
+
     // Update the target texture
     if (setActive(true))
     {
@@ -78,6 +78,9 @@ Vector2u RenderWindow::getSize() const
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // Make sure that pending draws are part of the capture
+    const_cast<RenderWindow*>(this)->flush();
+
     Image image;
     if (setActive())
     {
@@ -99,6 +102,31 @@ Image RenderWindow::capture() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderWindow::captureAsync(ImageReadback& readback) const
+{
+    // Fall back to a synchronous capture if pixel buffers are not supported
+    if (!ImageReadback::isAvailable())
+    {
+        readback.setImage(capture());
+        return true;
+    }
+
+    // Make sure that pending draws are part of the capture
+    const_cast<RenderWindow*>(this)->flush();
+
+    if (!setActive())
+        return false;
+
+    // OpenGL's origin is bottom while SFML's origin is top, rows are flipped when the image is retrieved
+    readback.beginRead(getSize(), getSize(), true);
+    glCheck(glReadPixels(0, 0, getSize().x, getSize().y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    readback.endRead();
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
@@ -114,4 +142,12 @@ void RenderWindow::onResize()
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Render the pending batch before the back buffer is presented
+    RenderTarget::endFrame();
+}
+
 } // namespace sf
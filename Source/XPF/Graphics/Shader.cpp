@@ -36,7 +36,10 @@
 #include <XPF/System/Mutex.hpp>
 #include <XPF/System/Lock.hpp>
 #include <XPF/System/Err.hpp>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 
 
@@ -57,6 +60,8 @@
 namespace
 {
     sf::Mutex mutex;
+    std::string binaryCacheDirectory;
+    sf::Uint64 uniformGeneration = 0;
 
     GLint checkMaxTextureUnits()
     {
@@ -116,6 +121,115 @@ namespace
         return success;
     }
 
+    // Hash a string into a 64-bits FNV-1a hash
+    void hashString(const char* string, sf::Uint64& hash)
+    {
+        if (string)
+        {
+            for (; *string; ++string)
+            {
+                hash ^= static_cast<unsigned char>(*string);
+                hash *= 1099511628211ULL;
+            }
+        }
+
+        // Separate consecutive strings
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+    }
+
+    // Build the path of the binary cache entry for the given sources, or an empty string if binaries can't be used
+    std::string getBinaryCachePath(const char* vertexShaderCode, const char* fragmentShaderCode)
+    {
+        std::string directory;
+        {
+            sf::Lock lock(mutex);
+            directory = binaryCacheDirectory;
+        }
+
+        if (directory.empty() || !GLEXT_get_program_binary)
+            return "";
+
+        // The driver may support the extension without providing any binary format
+        GLint formats = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+        if (formats <= 0)
+            return "";
+
+        // Binaries are only valid for the driver that produced them
+        sf::Uint64 hash = 14695981039346656037ULL;
+        hashString(vertexShaderCode, hash);
+        hashString(fragmentShaderCode, hash);
+        hashString(reinterpret_cast<const char*>(glGetString(GL_VENDOR)), hash);
+        hashString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), hash);
+        hashString(reinterpret_cast<const char*>(glGetString(GL_VERSION)), hash);
+
+        std::ostringstream path;
+        path << directory;
+        if ((directory[directory.size() - 1] != '/') && (directory[directory.size() - 1] != '\\'))
+            path << '/';
+        path << std::hex << std::setfill('0') << std::setw(16) << hash << ".bin";
+
+        return path.str();
+    }
+
+    // Create a program from a cached binary, returns 0 if there is no usable binary
+    GLEXT_GLhandle loadProgramBinary(const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+            return 0;
+
+        // The file contains the binary format followed by the binary itself
+        file.seekg(0, std::ios_base::end);
+        std::streamsize size = file.tellg();
+        if (size <= static_cast<std::streamsize>(sizeof(sf::Uint32)))
+            return 0;
+
+        std::vector<char> buffer(static_cast<std::size_t>(size));
+        file.seekg(0, std::ios_base::beg);
+        if (!file.read(&buffer[0], size))
+            return 0;
+
+        sf::Uint32 format;
+        std::memcpy(&format, &buffer[0], sizeof(format));
+
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glCreateProgramObject());
+        glCheck(GLEXT_glProgramBinary(castFromGlHandle(program), static_cast<GLenum>(format), &buffer[sizeof(format)], static_cast<GLsizei>(buffer.size() - sizeof(format))));
+
+        // The driver rejects binaries that it can no longer use
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return program;
+    }
+
+    // Save the binary of a linked program to the cache
+    void saveProgramBinary(GLEXT_GLhandle program, const std::string& path)
+    {
+        GLint length = 0;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> buffer(sizeof(sf::Uint32) + static_cast<std::size_t>(length));
+        GLenum format = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), length, NULL, &format, &buffer[sizeof(sf::Uint32)]));
+
+        sf::Uint32 storedFormat = static_cast<sf::Uint32>(format);
+        std::memcpy(&buffer[0], &storedFormat, sizeof(storedFormat));
+
+        std::ofstream file(path.c_str(), std::ios_base::binary);
+        if (!file || !file.write(&buffer[0], static_cast<std::streamsize>(buffer.size())))
+            sf::err() << "Failed to save shader binary to \"" << path << "\"" << std::endl;
+    }
+
     bool checkShadersAvailable()
     {
         // Create a temporary context in case the user checks
@@ -215,10 +329,9 @@ struct Shader::UniformBinder : private NonCopyable
     /// \brief Constructor: set up state before uniform is set
     ///
     ////////////////////////////////////////////////////////////
-    UniformBinder(Shader& shader, const std::string& name) :
+    UniformBinder(Shader& shader) :
     savedProgram(0),
-    currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
+    currentProgram(castToGlHandle(shader.m_shaderProgram))
     {
         if (currentProgram)
         {
@@ -228,9 +341,6 @@ struct Shader::UniformBinder : private NonCopyable
             glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
             if (currentProgram != savedProgram)
                 glCheck(GLEXT_glUseProgramObject(currentProgram));
-
-            // Store uniform location for further use outside constructor
-            location = shader.getUniformLocation(name);
         }
     }
 
@@ -247,16 +357,53 @@ struct Shader::UniformBinder : private NonCopyable
 
     GLEXT_GLhandle savedProgram;   ///< Handle to the previously active program object
     GLEXT_GLhandle currentProgram; ///< Handle to the program object of the modified sf::Shader instance
-    GLint          location;       ///< Uniform location, used by the surrounding sf::Shader code
 };
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformValue::UniformValue(int location) :
+location(location),
+type    (Float1),
+count   (0),
+floats  (),
+dirty   (false)
+{
+    ints[0] = ints[1] = ints[2] = ints[3] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::UniformValue::apply() const
+{
+    GLsizei length = static_cast<GLsizei>(count);
+
+    switch (type)
+    {
+        case Float1:  glCheck(GLEXT_glUniform1fv(location, length, &floats[0])); break;
+        case Float2:  glCheck(GLEXT_glUniform2fv(location, length, &floats[0])); break;
+        case Float3:  glCheck(GLEXT_glUniform3fv(location, length, &floats[0])); break;
+        case Float4:  glCheck(GLEXT_glUniform4fv(location, length, &floats[0])); break;
+        case Int1:    glCheck(GLEXT_glUniform1i(location, ints[0])); break;
+        case Int2:    glCheck(GLEXT_glUniform2i(location, ints[0], ints[1])); break;
+        case Int3:    glCheck(GLEXT_glUniform3i(location, ints[0], ints[1], ints[2])); break;
+        case Int4:    glCheck(GLEXT_glUniform4i(location, ints[0], ints[1], ints[2], ints[3])); break;
+        case Matrix3: glCheck(GLEXT_glUniformMatrix3fv(location, length, GL_FALSE, &floats[0])); break;
+        case Matrix4: glCheck(GLEXT_glUniformMatrix4fv(location, length, GL_FALSE, &floats[0])); break;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1),
-m_textures      (),
-m_uniforms      ()
+m_shaderProgram   (0),
+m_currentTexture  (-1),
+m_textures        (),
+m_uniforms        (),
+m_values          (),
+m_dirtyUniforms   (),
+m_deferredUniforms(false),
+m_blocks          (),
+m_generation      (0)
 {
 }
 
@@ -266,6 +413,9 @@ Shader::~Shader()
 {
     ensureGlContext();
 
+    // Destroy the uniform buffers
+    clearUniforms();
+
     // Destroy effect program
     if (m_shaderProgram)
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
@@ -380,118 +530,98 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& fragme
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1f(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, int x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1i(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, bool x)
 {
-    setUniform(name, static_cast<int>(x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec2& v)
 {
-    setUniform(name, Glsl::Ivec2(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec3& v)
 {
-    setUniform(name, Glsl::Ivec3(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec4& v)
 {
-    setUniform(name, Glsl::Ivec4(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat3& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat4& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
@@ -546,9 +676,7 @@ void Shader::setUniform(const std::string& name, CurrentTextureType)
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1fv(binder.location, length, scalarArray));
+    setUniformValue(getUniformHandle(name), Float1, scalarArray, NULL, length, length);
 }
 
 
@@ -556,10 +684,7 @@ void Shader::setUniformArray(const std::string& name, const float* scalarArray,
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2fv(binder.location, length, &contiguous[0]));
+    setUniformValue(getUniformHandle(name), Float2, &contiguous[0], NULL, contiguous.size(), length);
 }
 
 
@@ -567,10 +692,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorAr
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3fv(binder.location, length, &contiguous[0]));
+    setUniformValue(getUniformHandle(name), Float3, &contiguous[0], NULL, contiguous.size(), length);
 }
 
 
@@ -578,10 +700,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorAr
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4fv(binder.location, length, &contiguous[0]));
+    setUniformValue(getUniformHandle(name), Float4, &contiguous[0], NULL, contiguous.size(), length);
 }
 
 
@@ -594,9 +713,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, length, GL_FALSE, &contiguous[0]));
+    setUniformValue(getUniformHandle(name), Matrix3, &contiguous[0], NULL, contiguous.size(), length);
 }
 
 
@@ -609,9 +726,219 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, length, GL_FALSE, &contiguous[0]));
+    setUniformValue(getUniformHandle(name), Matrix4, &contiguous[0], NULL, contiguous.size(), length);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    if (!m_shaderProgram)
+        return UniformHandle();
+
+    // Check the cache
+    UniformTable::const_iterator it = m_uniforms.find(name);
+    if (it != m_uniforms.end())
+        return it->second;
+
+    // Not in cache, request the location from OpenGL
+    ensureGlContext();
+    int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
+
+    UniformHandle handle;
+    if (location != -1)
+    {
+        handle = UniformHandle(location, m_values.size(), m_generation);
+        m_values.push_back(UniformValue(location));
+    }
+    else
+    {
+        err() << "Parameter \"" << name << "\" not found in shader" << std::endl;
+    }
+
+    m_uniforms.insert(std::make_pair(name, handle));
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, float x)
+{
+    setUniformValue(uniform, Float1, &x, NULL, 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Vec2& v)
+{
+    float values[2] = {v.x, v.y};
+    setUniformValue(uniform, Float2, values, NULL, 2, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Vec3& v)
+{
+    float values[3] = {v.x, v.y, v.z};
+    setUniformValue(uniform, Float3, values, NULL, 3, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Vec4& v)
+{
+    float values[4] = {v.x, v.y, v.z, v.w};
+    setUniformValue(uniform, Float4, values, NULL, 4, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, int x)
+{
+    setUniformValue(uniform, Int1, NULL, &x, 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Ivec2& v)
+{
+    int values[2] = {v.x, v.y};
+    setUniformValue(uniform, Int2, NULL, values, 2, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Ivec3& v)
+{
+    int values[3] = {v.x, v.y, v.z};
+    setUniformValue(uniform, Int3, NULL, values, 3, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Ivec4& v)
+{
+    int values[4] = {v.x, v.y, v.z, v.w};
+    setUniformValue(uniform, Int4, NULL, values, 4, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, bool x)
+{
+    setUniform(uniform, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Bvec2& v)
+{
+    setUniform(uniform, Glsl::Ivec2(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Bvec3& v)
+{
+    setUniform(uniform, Glsl::Ivec3(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Bvec4& v)
+{
+    setUniform(uniform, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Mat3& matrix)
+{
+    setUniformValue(uniform, Matrix3, matrix.array, NULL, 3 * 3, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Mat4& matrix)
+{
+    setUniformValue(uniform, Matrix4, matrix.array, NULL, 4 * 4, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setDeferredUniforms(bool deferred)
+{
+    // Send the pending values before switching to immediate updates
+    if (m_deferredUniforms && !deferred && !m_dirtyUniforms.empty())
+    {
+        UniformBinder binder(*this);
+        flushUniforms();
+    }
+
+    m_deferredUniforms = deferred;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setUniformBlock(const std::string& name, const void* data, std::size_t size)
+{
+    if (!m_shaderProgram)
+        return false;
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_uniform_buffer_object)
+    {
+        err() << "Failed to set uniform block \"" << name << "\": your system doesn't support uniform buffers" << std::endl;
+        return false;
+    }
+
+    // Find the block, or prepare it if it is the first time it is used
+    std::vector<UniformBlock>::iterator block = m_blocks.begin();
+    while ((block != m_blocks.end()) && (block->name != name))
+        ++block;
+
+    if (block == m_blocks.end())
+    {
+        GLuint index = GLEXT_glGetUniformBlockIndex(static_cast<GLuint>(m_shaderProgram), name.c_str());
+        if (index == GLEXT_GL_INVALID_INDEX)
+        {
+            err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+            return false;
+        }
+
+        // Each block of the shader gets its own binding point
+        GLint maxBindings = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxBindings));
+        if (m_blocks.size() >= static_cast<std::size_t>(maxBindings))
+        {
+            err() << "Impossible to use uniform block \"" << name << "\" for shader: all available binding points are used" << std::endl;
+            return false;
+        }
+
+        GLuint binding = static_cast<GLuint>(m_blocks.size());
+        glCheck(GLEXT_glUniformBlockBinding(static_cast<GLuint>(m_shaderProgram), index, binding));
+
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+
+        UniformBlock newBlock;
+        newBlock.name   = name;
+        newBlock.buffer = static_cast<unsigned int>(buffer);
+        m_blocks.push_back(newBlock);
+        block = m_blocks.end() - 1;
+    }
+
+    // Updating a buffer doesn't require the program to be active
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, block->buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, size, data, GLEXT_GL_DYNAMIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    return true;
 }
 
 
@@ -710,8 +1037,12 @@ void Shader::bind(const Shader* shader)
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
 
-        // Bind the textures
+        // Send the uniforms that changed since the last bind
+        shader->flushUniforms();
+
+        // Bind the textures and uniform buffers
         shader->bindTextures();
+        shader->bindUniformBlocks();
 
         // Bind the current texture
         if (shader->m_currentTexture != -1)
@@ -737,6 +1068,15 @@ bool Shader::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+    Lock lock(mutex);
+
+    binaryCacheDirectory = directory;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
 {
@@ -760,7 +1100,24 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
     // Reset the internal state
     m_currentTexture = -1;
     m_textures.clear();
-    m_uniforms.clear();
+    clearUniforms();
+
+    // Reuse the binary of a previous compilation if there is one
+    std::string binaryPath = getBinaryCachePath(vertexShaderCode, fragmentShaderCode);
+    if (!binaryPath.empty())
+    {
+        GLEXT_GLhandle cachedProgram = loadProgramBinary(binaryPath);
+        if (cachedProgram)
+        {
+            m_shaderProgram = castFromGlHandle(cachedProgram);
+
+            // Force an OpenGL flush, so that the shader will appear updated
+            // in all contexts immediately (solves problems in multi-threaded apps)
+            glCheck(glFlush());
+
+            return true;
+        }
+    }
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
@@ -822,6 +1179,10 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
         glCheck(GLEXT_glDeleteObject(fragmentShader));
     }
 
+    // Ask the driver to keep the binary around so that we can cache it
+    if (!binaryPath.empty())
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
@@ -840,6 +1201,10 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
 
     m_shaderProgram = castFromGlHandle(shaderProgram);
 
+    // Store the binary for the next compilation of the same sources
+    if (!binaryPath.empty())
+        saveProgramBinary(shaderProgram, binaryPath);
+
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
@@ -866,27 +1231,85 @@ void Shader::bindTextures() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::bindUniformBlocks() const
+{
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        glCheck(GLEXT_glBindBufferBase(GLEXT_GL_UNIFORM_BUFFER, static_cast<GLuint>(i), m_blocks[i].buffer));
+}
+
+
 ////////////////////////////////////////////////////////////
 int Shader::getUniformLocation(const std::string& name)
 {
-    // Check the cache
-    UniformTable::const_iterator it = m_uniforms.find(name);
-    if (it != m_uniforms.end())
+    return getUniformHandle(name).m_location;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformValue(const UniformHandle& uniform, UniformType type, const float* floats, const int* ints, std::size_t size, std::size_t count)
+{
+    // Ignore invalid handles, and handles from another shader or a previous program
+    if ((uniform.m_location == -1) || (uniform.m_generation != m_generation))
+        return;
+
+    // Store the value
+    UniformValue& value = m_values[uniform.m_slot];
+    value.type  = type;
+    value.count = count;
+    if (floats)
+        value.floats.assign(floats, floats + size);
+    else
+        std::copy(ints, ints + size, value.ints);
+
+    if (m_deferredUniforms)
     {
-        // Already in cache, return it
-        return it->second;
+        // Send it on next bind
+        if (!value.dirty)
+        {
+            value.dirty = true;
+            m_dirtyUniforms.push_back(uniform.m_slot);
+        }
     }
     else
     {
-        // Not in cache, request the location from OpenGL
-        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
-        m_uniforms.insert(std::make_pair(name, location));
+        // Send it now
+        UniformBinder binder(*this);
+        value.apply();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::flushUniforms() const
+{
+    for (std::vector<std::size_t>::const_iterator it = m_dirtyUniforms.begin(); it != m_dirtyUniforms.end(); ++it)
+    {
+        m_values[*it].apply();
+        m_values[*it].dirty = false;
+    }
+
+    m_dirtyUniforms.clear();
+}
 
-        if (location == -1)
-            err() << "Parameter \"" << name << "\" not found in shader" << std::endl;
 
-        return location;
+////////////////////////////////////////////////////////////
+void Shader::clearUniforms()
+{
+    for (std::vector<UniformBlock>::const_iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+    {
+        GLuint buffer = static_cast<GLuint>(it->buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
     }
+
+    m_uniforms.clear();
+    m_values.clear();
+    m_dirtyUniforms.clear();
+    m_blocks.clear();
+
+    // Handles retrieved from now on must not be mistaken for the previous ones
+    Lock lock(mutex);
+    m_generation = ++uniformGeneration;
 }
 
 } // namespace sf
@@ -903,8 +1326,10 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1)
+m_shaderProgram   (0),
+m_currentTexture  (-1),
+m_deferredUniforms(false),
+m_generation      (0)
 {
 }
 
@@ -1089,6 +1514,110 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return UniformHandle();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& uniform, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setDeferredUniforms(bool deferred)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setUniformBlock(const std::string& name, const void* data, std::size_t size)
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1169,6 +1698,12 @@ bool Shader::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
 {
@@ -1184,3 +1719,32 @@ void Shader::bindTextures() const
 } // namespace sf
 
 #endif // SFML_OPENGL_ES
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle() :
+m_location  (-1),
+m_slot      (0),
+m_generation(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle(int location, std::size_t slot, Uint64 generation) :
+m_location  (location),
+m_slot      (slot),
+m_generation(generation)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::UniformHandle::isValid() const
+{
+    return m_location != -1;
+}
+
+} // namespace sf
@@ -0,0 +1,571 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/ShaderPipeline.hpp>
+#include <XPF/Graphics/Shader.hpp>
+#include <XPF/Graphics/Texture.hpp>
+#include <XPF/Graphics/GLCheck.hpp>
+#include <XPF/Window/Context.hpp>
+#include <XPF/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    // Default vertex shader, equivalent to the fixed-function pipeline used by sf::RenderTarget
+    const char* vertexShaderSource =
+        "#version 150\n"
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "in vec2 sf_texCoords;\n"
+        "uniform mat4 sf_projection;\n"
+        "uniform mat4 sf_modelView;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "out vec4 sf_vertexColor;\n"
+        "out vec2 sf_vertexTexCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_projection * sf_modelView * vec4(sf_position, 0.0, 1.0);\n"
+        "    sf_vertexColor = sf_color;\n"
+        "    sf_vertexTexCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    // Default fragment shader: vertex color modulated by the texture, if any
+    const char* fragmentShaderSource =
+        "#version 150\n"
+        "uniform sampler2D sf_texture;\n"
+        "uniform int sf_textureEnabled;\n"
+        "in vec4 sf_vertexColor;\n"
+        "in vec2 sf_vertexTexCoords;\n"
+        "out vec4 sf_fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_fragColor = sf_vertexColor;\n"
+        "    if (sf_textureEnabled != 0)\n"
+        "        sf_fragColor *= texture(sf_texture, sf_vertexTexCoords);\n"
+        "}\n";
+
+    // Attribute locations of the default program
+    enum
+    {
+        PositionLocation  = 0,
+        ColorLocation     = 1,
+        TexCoordsLocation = 2
+    };
+
+    const float identityMatrix[16] = {1.f, 0.f, 0.f, 0.f,
+                                      0.f, 1.f, 0.f, 0.f,
+                                      0.f, 0.f, 1.f, 0.f,
+                                      0.f, 0.f, 0.f, 1.f};
+
+    // Compile a shader, log the compilation errors and return 0 if it failed
+    GLuint compileShader(GLenum type, const char* source)
+    {
+        GLuint shader = glCreateShader(type);
+        glCheck(glShaderSource(shader, 1, &source, NULL));
+        glCheck(glCompileShader(shader));
+
+        GLint success;
+        glCheck(glGetShaderiv(shader, GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(glGetShaderInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile the default "
+                      << ((type == GL_VERTEX_SHADER) ? "vertex" : "fragment") << " shader:" << std::endl
+                      << log << std::endl;
+            glCheck(glDeleteShader(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ShaderPipeline::ShaderPipeline() :
+m_defaultProgram  (0),
+m_program         (0),
+m_locations       (),
+m_locationTable   (),
+m_vertexArray     (0),
+m_vertexBuffer    (0),
+m_vertexBufferSize(0),
+m_quadVertices    (),
+m_textureEnabled  (false),
+m_uniformsDirty   (true)
+{
+    std::memcpy(m_projection, identityMatrix, sizeof(identityMatrix));
+    std::memcpy(m_modelView, identityMatrix, sizeof(identityMatrix));
+    std::memcpy(m_textureMatrix, identityMatrix, sizeof(identityMatrix));
+}
+
+
+////////////////////////////////////////////////////////////
+ShaderPipeline::~ShaderPipeline()
+{
+    ensureGlContext();
+
+    // The program and the buffer are shared between contexts; the vertex array
+    // object is not, and is destroyed along with the context of the target
+    if (m_vertexBuffer)
+        glCheck(glDeleteBuffers(1, &m_vertexBuffer));
+
+    if (m_defaultProgram)
+        glCheck(glDeleteProgram(m_defaultProgram));
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderPipeline::isRequired()
+{
+    const Context* context = Context::getActiveContext();
+
+    return context && (context->getSettings().attributeFlags & ContextSettings::Core);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderPipeline::create()
+{
+    ensureExtensionsInit();
+
+    if (!GLEXT_programmable_pipeline)
+    {
+        err() << "Failed to create the programmable pipeline: OpenGL 2.0 is not supported" << std::endl;
+        return false;
+    }
+
+    // Create the default program
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+
+    if (!vertexShader || !fragmentShader)
+    {
+        if (vertexShader)
+            glCheck(glDeleteShader(vertexShader));
+        if (fragmentShader)
+            glCheck(glDeleteShader(fragmentShader));
+        return false;
+    }
+
+    GLuint program = glCreateProgram();
+    glCheck(glAttachShader(program, vertexShader));
+    glCheck(glAttachShader(program, fragmentShader));
+    glCheck(glBindAttribLocation(program, PositionLocation, "sf_position"));
+    glCheck(glBindAttribLocation(program, ColorLocation, "sf_color"));
+    glCheck(glBindAttribLocation(program, TexCoordsLocation, "sf_texCoords"));
+    glCheck(glLinkProgram(program));
+
+    // The shaders are released along with the program
+    glCheck(glDeleteShader(vertexShader));
+    glCheck(glDeleteShader(fragmentShader));
+
+    GLint success;
+    glCheck(glGetProgramiv(program, GL_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        char log[1024];
+        glCheck(glGetProgramInfoLog(program, sizeof(log), 0, log));
+        err() << "Failed to link the default shader:" << std::endl
+              << log << std::endl;
+        glCheck(glDeleteProgram(program));
+        return false;
+    }
+
+    m_defaultProgram = program;
+
+    // Create the streaming vertex buffer
+    glCheck(glGenBuffers(1, &m_vertexBuffer));
+
+    // Core profiles can't draw without a vertex array object
+    if (GLEXT_vertex_array_object)
+        glCheck(GLEXT_glGenVertexArrays(1, &m_vertexArray));
+
+    setProgram(0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setProjection(const float* matrix)
+{
+    std::memcpy(m_projection, matrix, sizeof(m_projection));
+    m_uniformsDirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setModelView(const float* matrix)
+{
+    std::memcpy(m_modelView, matrix, sizeof(m_modelView));
+    m_uniformsDirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setTexture(const Texture* texture)
+{
+    if (texture && texture->m_texture)
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+
+        // Convert the range [0 .. size] to [0 .. 1], like Texture::bind does with the texture matrix
+        std::memcpy(m_textureMatrix, identityMatrix, sizeof(identityMatrix));
+        m_textureMatrix[0] = 1.f / texture->m_actualSize.x;
+        m_textureMatrix[5] = 1.f / texture->m_actualSize.y;
+
+        // If pixels are flipped we must invert the Y axis
+        if (texture->m_pixelsFlipped)
+        {
+            m_textureMatrix[5] = -m_textureMatrix[5];
+            m_textureMatrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
+        }
+
+        m_textureEnabled = true;
+    }
+    else
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        m_textureEnabled = false;
+    }
+
+    m_uniformsDirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setProgram(unsigned int program)
+{
+    if (!program)
+        program = m_defaultProgram;
+
+    glCheck(glUseProgram(program));
+
+    if (program != m_program)
+    {
+        m_program = program;
+
+        // Look up the built-in variables the first time a program is used
+        LocationTable::iterator it = m_locationTable.find(program);
+        if (it == m_locationTable.end())
+        {
+            Locations locations;
+            locations.position       = glGetAttribLocation(program, "sf_position");
+            locations.color          = glGetAttribLocation(program, "sf_color");
+            locations.texCoords      = glGetAttribLocation(program, "sf_texCoords");
+            locations.projection     = glGetUniformLocation(program, "sf_projection");
+            locations.modelView      = glGetUniformLocation(program, "sf_modelView");
+            locations.textureMatrix  = glGetUniformLocation(program, "sf_textureMatrix");
+            locations.texture        = glGetUniformLocation(program, "sf_texture");
+            locations.textureEnabled = glGetUniformLocation(program, "sf_textureEnabled");
+
+            it = m_locationTable.insert(std::make_pair(program, locations)).first;
+        }
+
+        m_locations = it->second;
+    }
+
+    // Uniforms are per program, and a shader may have changed ours
+    m_uniformsDirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setShader(const Shader* shader)
+{
+    setProgram(shader ? shader->m_shaderProgram : 0);
+
+    if (!shader || !shader->m_shaderProgram)
+        return;
+
+    // Send the uniforms that changed since the last bind
+    shader->flushUniforms();
+
+    // Bind the textures of the shader to the units following the one of the current texture
+    Shader::TextureTable::const_iterator it = shader->m_textures.begin();
+    for (GLint unit = 1; it != shader->m_textures.end(); ++it, ++unit)
+    {
+        glCheck(glUniform1i(it->first, unit));
+        glCheck(glActiveTexture(GL_TEXTURE0 + unit));
+        glCheck(glBindTexture(GL_TEXTURE_2D, it->second->m_texture));
+    }
+
+    // Make sure that the texture unit which is left active is the number 0
+    glCheck(glActiveTexture(GL_TEXTURE0));
+
+    shader->bindUniformBlocks();
+
+    // The current texture is the one bound to unit 0 by setTexture
+    if (shader->m_currentTexture != -1)
+        glCheck(glUniform1i(shader->m_currentTexture, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type)
+{
+    // GL_QUADS doesn't exist anymore, split each quad into two triangles
+    if (type == Quads)
+    {
+        std::size_t quadCount = vertexCount / 4;
+        m_quadVertices.resize(quadCount * 6);
+
+        for (std::size_t i = 0; i < quadCount; ++i)
+        {
+            const Vertex* quad = vertices + i * 4;
+            Vertex* triangles = &m_quadVertices[i * 6];
+
+            triangles[0] = quad[0];
+            triangles[1] = quad[1];
+            triangles[2] = quad[2];
+            triangles[3] = quad[0];
+            triangles[4] = quad[2];
+            triangles[5] = quad[3];
+        }
+
+        vertices = m_quadVertices.empty() ? NULL : &m_quadVertices[0];
+        vertexCount = m_quadVertices.size();
+    }
+
+    if (!vertexCount)
+        return;
+
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer));
+
+    // Orphan the previous storage so that we don't wait for pending draws to complete
+    if (vertexCount > m_vertexBufferSize)
+        m_vertexBufferSize = std::max(vertexCount, m_vertexBufferSize * 2);
+    glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_vertexBufferSize, NULL, GL_STREAM_DRAW));
+    glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * vertexCount, vertices));
+
+    setupAttributes();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setVertexBuffer(unsigned int buffer)
+{
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+
+    setupAttributes();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::draw(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_TRIANGLES};
+
+    // Quads were converted to triangles when they were streamed
+    if (type == Quads)
+    {
+        firstVertex = firstVertex / 4 * 6;
+        vertexCount = vertexCount / 4 * 6;
+    }
+
+    flushUniforms();
+
+    glCheck(glDrawArrays(modes[type], static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setupAttributes()
+{
+    if (m_vertexArray)
+        glCheck(GLEXT_glBindVertexArray(m_vertexArray));
+
+    // The components of the vertices are offsets into the bound buffer
+    const char* data = NULL;
+
+    if (m_locations.position >= 0)
+    {
+        glCheck(glEnableVertexAttribArray(m_locations.position));
+        glCheck(glVertexAttribPointer(m_locations.position, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), data + 0));
+    }
+
+    if (m_locations.color >= 0)
+    {
+        glCheck(glEnableVertexAttribArray(m_locations.color));
+        glCheck(glVertexAttribPointer(m_locations.color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), data + 8));
+    }
+
+    if (m_locations.texCoords >= 0)
+    {
+        glCheck(glEnableVertexAttribArray(m_locations.texCoords));
+        glCheck(glVertexAttribPointer(m_locations.texCoords, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), data + 12));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::flushUniforms()
+{
+    if (!m_uniformsDirty)
+        return;
+
+    if (m_locations.projection >= 0)
+        glCheck(glUniformMatrix4fv(m_locations.projection, 1, GL_FALSE, m_projection));
+
+    if (m_locations.modelView >= 0)
+        glCheck(glUniformMatrix4fv(m_locations.modelView, 1, GL_FALSE, m_modelView));
+
+    if (m_locations.textureMatrix >= 0)
+        glCheck(glUniformMatrix4fv(m_locations.textureMatrix, 1, GL_FALSE, m_textureMatrix));
+
+    // User shaders bind their own textures to the other units
+    if (m_locations.texture >= 0)
+        glCheck(glUniform1i(m_locations.texture, 0));
+
+    if (m_locations.textureEnabled >= 0)
+        glCheck(glUniform1i(m_locations.textureEnabled, m_textureEnabled ? 1 : 0));
+
+    m_uniformsDirty = false;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ShaderPipeline::ShaderPipeline() :
+m_defaultProgram  (0),
+m_program         (0),
+m_locations       (),
+m_locationTable   (),
+m_vertexArray     (0),
+m_vertexBuffer    (0),
+m_vertexBufferSize(0),
+m_quadVertices    (),
+m_textureEnabled  (false),
+m_uniformsDirty   (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ShaderPipeline::~ShaderPipeline()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderPipeline::isRequired()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderPipeline::create()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setProjection(const float* matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setModelView(const float* matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setTexture(const Texture* texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setProgram(unsigned int program)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setShader(const Shader* shader)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setVertexBuffer(unsigned int buffer)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::draw(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::setupAttributes()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderPipeline::flushUniforms()
+{
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
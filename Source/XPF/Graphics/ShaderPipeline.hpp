@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHADERPIPELINE_HPP
+#define SFML_SHADERPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/PrimitiveType.hpp>
+#include <XPF/Graphics/Vertex.hpp>
+#include <XPF/Window/GlResource.hpp>
+#include <XPF/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Shader;
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Programmable replacement of the fixed-function
+///        pipeline, used by render targets whose context
+///        is a core profile
+///
+////////////////////////////////////////////////////////////
+class ShaderPipeline : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ShaderPipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ShaderPipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the active context requires the programmable pipeline
+    ///
+    /// \return True if the active context is a core profile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isRequired();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the default program and the vertex buffer
+    ///
+    /// The context of the render target must be active.
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the projection matrix (the view)
+    ///
+    /// \param matrix 4x4 matrix of the view
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProjection(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the model-view matrix (the transform of the entity)
+    ///
+    /// \param matrix 4x4 matrix of the transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setModelView(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a texture, whose coordinates are in pixels
+    ///
+    /// \param texture Texture to bind, can be null
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use a program
+    ///
+    /// The attributes and uniforms of the program are looked up
+    /// by name (sf_position, sf_color, sf_texCoords, sf_projection,
+    /// sf_modelView, sf_textureMatrix, sf_texture and
+    /// sf_textureEnabled); the ones it doesn't declare are ignored.
+    ///
+    /// \param program Native handle of the program, 0 for the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProgram(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use a shader, or the default program
+    ///
+    /// Unlike Shader::bind, the textures of the shader are bound
+    /// without the texture matrix, which core profiles lack.
+    /// The shader's uniforms are sent before the program is used
+    /// for drawing.
+    ///
+    /// \param shader Shader to use, null for the default program
+    ///
+    ////////////////////////////////////////////////////////////
+    void setShader(const Shader* shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stream vertices to the internal vertex buffer
+    ///
+    /// Quads are converted to triangles on the fly.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source the vertices from an external vertex buffer
+    ///
+    /// \param buffer OpenGL identifier of the vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexBuffer(unsigned int buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives from the current vertex source
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to use when drawing
+    /// \param vertexCount Number of vertices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Locations of the built-in variables in a program
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Locations
+    {
+        int position;       ///< Location of the sf_position attribute
+        int color;          ///< Location of the sf_color attribute
+        int texCoords;      ///< Location of the sf_texCoords attribute
+        int projection;     ///< Location of the sf_projection uniform
+        int modelView;      ///< Location of the sf_modelView uniform
+        int textureMatrix;  ///< Location of the sf_textureMatrix uniform
+        int texture;        ///< Location of the sf_texture uniform
+        int textureEnabled; ///< Location of the sf_textureEnabled uniform
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup the vertex attributes from the bound vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupAttributes();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the uniforms which changed since the last draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushUniforms();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    typedef std::map<unsigned int, Locations> LocationTable;
+
+    unsigned int        m_defaultProgram;    ///< Program used when no shader is bound
+    unsigned int        m_program;           ///< Program currently in use
+    Locations           m_locations;         ///< Locations of the built-in variables in the current program
+    LocationTable       m_locationTable;     ///< Locations of the built-in variables, per program
+    unsigned int        m_vertexArray;       ///< Vertex array object, if supported
+    unsigned int        m_vertexBuffer;      ///< Streaming vertex buffer
+    std::size_t         m_vertexBufferSize;  ///< Capacity of the streaming vertex buffer, in vertices
+    std::vector<Vertex> m_quadVertices;      ///< Scratch storage for quads converted to triangles
+    float               m_projection[16];    ///< Current projection matrix
+    float               m_modelView[16];     ///< Current model-view matrix
+    float               m_textureMatrix[16]; ///< Current texture matrix
+    bool                m_textureEnabled;    ///< Is a texture bound?
+    bool                m_uniformsDirty;     ///< Must the uniforms be uploaded before the next draw?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SHADERPIPELINE_HPP
@@ -130,8 +130,11 @@ const Color& Shape::getOutlineColor() const
 ////////////////////////////////////////////////////////////
 void Shape::setOutlineThickness(float thickness)
 {
-    m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+    if (thickness != m_outlineThickness)
+    {
+        m_outlineThickness = thickness;
+        updateOutlineThickness(); // only the outer outline points move
+    }
 }
 
 
@@ -166,7 +169,9 @@ m_outlineThickness(0),
 m_vertices        (TrianglesFan),
 m_outlineVertices (TrianglesStrip),
 m_insideBounds    (),
-m_bounds          ()
+m_bounds          (),
+m_positions       (),
+m_outlineNormals  ()
 {
 }
 
@@ -180,14 +185,19 @@ void Shape::update()
     {
         m_vertices.resize(0);
         m_outlineVertices.resize(0);
+        m_outlineNormals.clear();
         return;
     }
 
+    // Colors only have to be written to new vertices, existing ones keep theirs
+    bool resized = (m_vertices.getVertexCount() != count + 2);
     m_vertices.resize(count + 2); // + 2 for center and repeated first point
 
     // Position
+    m_positions.resize(count);
+    getPoints(&m_positions[0]);
     for (std::size_t i = 0; i < count; ++i)
-        m_vertices[i + 1].position = getPoint(i);
+        m_vertices[i + 1].position = m_positions[i];
     m_vertices[count + 1].position = m_vertices[1].position;
 
     // Update the bounding rectangle
@@ -199,7 +209,8 @@ void Shape::update()
     m_vertices[0].position.y = m_insideBounds.top + m_insideBounds.height / 2;
 
     // Color
-    updateFillColors();
+    if (resized)
+        updateFillColors();
 
     // Texture coordinates
     updateTexCoords();
@@ -209,11 +220,24 @@ void Shape::update()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shape::getPoints(Vector2f* points) const
+{
+    std::size_t count = getPointCount();
+    for (std::size_t i = 0; i < count; ++i)
+        points[i] = getPoint(i);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shape::draw(RenderTarget& target, RenderStates states) const
 {
     states.transform *= getTransform();
 
+    // Skip the shape if it is outside the view
+    if (target.isCullingEnabled() && target.isCulled(m_bounds, states.transform))
+        return;
+
     // Render the inside
     states.texture = m_texture;
     target.draw(m_vertices, states);
@@ -238,12 +262,13 @@ void Shape::updateFillColors()
 ////////////////////////////////////////////////////////////
 void Shape::updateTexCoords()
 {
+    float xscale = m_insideBounds.width > 0 ? m_textureRect.width / m_insideBounds.width : 0;
+    float yscale = m_insideBounds.height > 0 ? m_textureRect.height / m_insideBounds.height : 0;
+
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
     {
-        float xratio = m_insideBounds.width > 0 ? (m_vertices[i].position.x - m_insideBounds.left) / m_insideBounds.width : 0;
-        float yratio = m_insideBounds.height > 0 ? (m_vertices[i].position.y - m_insideBounds.top) / m_insideBounds.height : 0;
-        m_vertices[i].texCoords.x = m_textureRect.left + m_textureRect.width * xratio;
-        m_vertices[i].texCoords.y = m_textureRect.top + m_textureRect.height * yratio;
+        m_vertices[i].texCoords.x = m_textureRect.left + (m_vertices[i].position.x - m_insideBounds.left) * xscale;
+        m_vertices[i].texCoords.y = m_textureRect.top + (m_vertices[i].position.y - m_insideBounds.top) * yscale;
     }
 }
 
@@ -251,17 +276,19 @@ void Shape::updateTexCoords()
 ////////////////////////////////////////////////////////////
 void Shape::updateOutline()
 {
-    std::size_t count = m_vertices.getVertexCount() - 2;
+    std::size_t count = m_positions.size();
+    bool resized = (m_outlineVertices.getVertexCount() != (count + 1) * 2);
     m_outlineVertices.resize((count + 1) * 2);
+    m_outlineNormals.resize(count);
+
+    Vector2f center = m_vertices[0].position;
 
     for (std::size_t i = 0; i < count; ++i)
     {
-        std::size_t index = i + 1;
-
         // Get the two segments shared by the current point
-        Vector2f p0 = (i == 0) ? m_vertices[count].position : m_vertices[index - 1].position;
-        Vector2f p1 = m_vertices[index].position;
-        Vector2f p2 = m_vertices[index + 1].position;
+        const Vector2f& p0 = m_positions[(i == 0) ? count - 1 : i - 1];
+        const Vector2f& p1 = m_positions[i];
+        const Vector2f& p2 = m_positions[(i + 1 == count) ? 0 : i + 1];
 
         // Compute their normal
         Vector2f n1 = computeNormal(p0, p1);
@@ -269,26 +296,43 @@ void Shape::updateOutline()
 
         // Make sure that the normals point towards the outside of the shape
         // (this depends on the order in which the points were defined)
-        if (dotProduct(n1, m_vertices[0].position - p1) > 0)
+        if (dotProduct(n1, center - p1) > 0)
             n1 = -n1;
-        if (dotProduct(n2, m_vertices[0].position - p1) > 0)
+        if (dotProduct(n2, center - p1) > 0)
             n2 = -n2;
 
         // Combine them to get the extrusion direction
         float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        Vector2f normal = (n1 + n2) / factor;
+        m_outlineNormals[i] = (n1 + n2) / factor;
 
-        // Update the outline points
+        // Update the inner outline points, they don't depend on the thickness
         m_outlineVertices[i * 2 + 0].position = p1;
-        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
     }
 
     // Duplicate the first point at the end, to close the outline
     m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
-    m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
 
     // Update outline colors
-    updateOutlineColors();
+    if (resized)
+        updateOutlineColors();
+
+    // Extrude the outer outline points
+    updateOutlineThickness();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateOutlineThickness()
+{
+    std::size_t count = m_outlineNormals.size();
+    if (count == 0)
+        return;
+
+    for (std::size_t i = 0; i < count; ++i)
+        m_outlineVertices[i * 2 + 1].position = m_outlineVertices[i * 2].position + m_outlineNormals[i] * m_outlineThickness;
+
+    // Duplicate the first point at the end, to close the outline
+    m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
 
     // Update the shape's bounds
     m_bounds = m_outlineVertices.getBounds();
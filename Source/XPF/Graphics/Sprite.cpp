@@ -139,6 +139,11 @@ void Sprite::draw(RenderTarget& target, RenderStates states) const
     if (m_texture)
     {
         states.transform *= getTransform();
+
+        // Skip the sprite if it is outside the view
+        if (target.isCullingEnabled() && target.isCulled(getLocalBounds(), states.transform))
+            return;
+
         states.texture = m_texture;
         target.draw(m_vertices, 4, TrianglesStrip, states);
     }
@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/SpriteBatch.hpp>
+#include <XPF/Graphics/RenderTarget.hpp>
+#include <XPF/Graphics/Sprite.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace
+{
+    // Sort sprite indices by texture identifier
+    struct TextureOrder
+    {
+        TextureOrder(const std::vector<std::size_t>& textureIds) : textureIds(textureIds) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            return textureIds[left] < textureIds[right];
+        }
+
+        const std::vector<std::size_t>& textureIds;
+    };
+
+    // Move the last element of an array to the given index, and shrink the array
+    template <typename T>
+    void swapAndPop(std::vector<T>& array, std::size_t index)
+    {
+        array[index] = array.back();
+        array.pop_back();
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_orderNeedUpdate   (false),
+m_geometryNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_textures.clear();
+    m_textureIds.clear();
+    m_textureTable.clear();
+    m_textureRects.clear();
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_origins.clear();
+    m_colors.clear();
+
+    m_orderNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::reserve(std::size_t spriteCount)
+{
+    m_textures.reserve(spriteCount);
+    m_textureIds.reserve(spriteCount);
+    m_textureRects.reserve(spriteCount);
+    m_positions.reserve(spriteCount);
+    m_rotations.reserve(spriteCount);
+    m_scales.reserve(spriteCount);
+    m_origins.reserve(spriteCount);
+    m_colors.reserve(spriteCount);
+    m_order.reserve(spriteCount);
+    m_vertices.reserve(spriteCount * 6);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Texture& texture, const IntRect& textureRect, const Vector2f& position, float rotation,
+                             const Vector2f& scale, const Color& color, const Vector2f& origin)
+{
+    m_textureIds.push_back(getTextureId(&texture));
+    m_textures.push_back(&texture);
+    m_textureRects.push_back(textureRect);
+    m_positions.push_back(position);
+    m_rotations.push_back(rotation);
+    m_scales.push_back(scale);
+    m_origins.push_back(origin);
+    m_colors.push_back(color);
+
+    m_orderNeedUpdate = true;
+
+    return m_textures.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Sprite& sprite)
+{
+    m_textureIds.push_back(getTextureId(sprite.getTexture()));
+    m_textures.push_back(sprite.getTexture());
+    m_textureRects.push_back(sprite.getTextureRect());
+    m_positions.push_back(sprite.getPosition());
+    m_rotations.push_back(sprite.getRotation());
+    m_scales.push_back(sprite.getScale());
+    m_origins.push_back(sprite.getOrigin());
+    m_colors.push_back(sprite.getColor());
+
+    m_orderNeedUpdate = true;
+
+    return m_textures.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::remove(std::size_t index)
+{
+    swapAndPop(m_textures, index);
+    swapAndPop(m_textureIds, index);
+    swapAndPop(m_textureRects, index);
+    swapAndPop(m_positions, index);
+    swapAndPop(m_rotations, index);
+    swapAndPop(m_scales, index);
+    swapAndPop(m_origins, index);
+    swapAndPop(m_colors, index);
+
+    m_orderNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(std::size_t index, const Texture& texture)
+{
+    if (m_textures[index] != &texture)
+    {
+        m_textureIds[index] = getTextureId(&texture);
+        m_textures[index] = &texture;
+        m_orderNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureRect(std::size_t index, const IntRect& textureRect)
+{
+    m_textureRects[index] = textureRect;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_positions[index] = position;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setRotation(std::size_t index, float rotation)
+{
+    m_rotations[index] = rotation;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setScale(std::size_t index, const Vector2f& scale)
+{
+    m_scales[index] = scale;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_origins[index] = origin;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setColor(std::size_t index, const Color& color)
+{
+    m_colors[index] = color;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_textures.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    // One draw call per texture
+    for (std::vector<Batch>::const_iterator it = m_batches.begin(); it != m_batches.end(); ++it)
+    {
+        states.texture = it->texture;
+        target.draw(&m_vertices[it->first], it->count, Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getTextureId(const Texture* texture)
+{
+    // Consecutive sprites usually share their texture
+    if (!m_textures.empty() && (m_textures.back() == texture))
+        return m_textureIds.back();
+
+    // Textures seen for the first time get the next identifier
+    std::map<const Texture*, std::size_t>::iterator it = m_textureTable.find(texture);
+    if (it == m_textureTable.end())
+        it = m_textureTable.insert(std::make_pair(texture, m_textureTable.size())).first;
+
+    return it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::ensureGeometryUpdate() const
+{
+    // Group the sprites by texture, in the order the textures were first used (keeping the index order within a texture)
+    if (m_orderNeedUpdate)
+    {
+        m_order.resize(m_textures.size());
+        for (std::size_t i = 0; i < m_order.size(); ++i)
+            m_order[i] = i;
+        std::stable_sort(m_order.begin(), m_order.end(), TextureOrder(m_textureIds));
+
+        m_orderNeedUpdate    = false;
+        m_geometryNeedUpdate = true;
+    }
+
+    if (!m_geometryNeedUpdate)
+        return;
+
+    m_geometryNeedUpdate = false;
+
+    // Expand all the sprites to quads (two triangles each)
+    m_vertices.resize(m_order.size() * 6);
+    m_batches.clear();
+    for (std::size_t i = 0; i < m_order.size(); ++i)
+    {
+        std::size_t index = m_order[i];
+
+        // Start a new range of vertices when the texture changes
+        if (m_batches.empty() || (m_batches.back().texture != m_textures[index]))
+        {
+            Batch batch = {m_textures[index], i * 6, 0};
+            m_batches.push_back(batch);
+        }
+        m_batches.back().count += 6;
+
+        // Compute the sprite's transform, the same way as sf::Transformable
+        float angle  = -m_rotations[index] * 3.141592654f / 180.f;
+        float cosine = static_cast<float>(std::cos(angle));
+        float sine   = static_cast<float>(std::sin(angle));
+        float sxc    = m_scales[index].x * cosine;
+        float syc    = m_scales[index].y * cosine;
+        float sxs    = m_scales[index].x * sine;
+        float sys    = m_scales[index].y * sine;
+        float tx     = -m_origins[index].x * sxc - m_origins[index].y * sys + m_positions[index].x;
+        float ty     =  m_origins[index].x * sxs - m_origins[index].y * syc + m_positions[index].y;
+
+        // The corners of the quad are the top-left one, plus its transformed width and height vectors
+        const IntRect& rect = m_textureRects[index];
+        float width  = static_cast<float>(std::abs(rect.width));
+        float height = static_cast<float>(std::abs(rect.height));
+
+        Vector2f topLeft(tx, ty);
+        Vector2f across(sxc * width, -sxs * width);
+        Vector2f down(sys * height, syc * height);
+
+        float left   = static_cast<float>(rect.left);
+        float right  = left + rect.width;
+        float top    = static_cast<float>(rect.top);
+        float bottom = top + rect.height;
+
+        const Color& color = m_colors[index];
+        Vertex* quad = &m_vertices[i * 6];
+        quad[0] = Vertex(topLeft,                 color, Vector2f(left, top));
+        quad[1] = Vertex(topLeft + down,          color, Vector2f(left, bottom));
+        quad[2] = Vertex(topLeft + across,        color, Vector2f(right, top));
+        quad[3] = quad[2];
+        quad[4] = quad[1];
+        quad[5] = Vertex(topLeft + across + down, color, Vector2f(right, bottom));
+    }
+}
+
+} // namespace sf
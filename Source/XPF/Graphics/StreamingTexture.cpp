@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/StreamingTexture.hpp>
+#include <XPF/Graphics/GLCheck.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+StreamingTexture::StreamingTexture() :
+m_texture(),
+m_buffers(),
+m_current(0),
+m_mapped (NULL),
+m_pixels ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+StreamingTexture::~StreamingTexture()
+{
+    destroyBuffers();
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::create(unsigned int width, unsigned int height, unsigned int slotCount)
+{
+    destroyBuffers();
+
+    if (!m_texture.create(width, height))
+    {
+        m_texture = Texture();
+        return false;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (GLEXT_pixel_buffer_object && GLEXT_vertex_buffer_object && (slotCount > 0))
+    {
+        m_buffers.resize(slotCount);
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            GLuint buffer;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, width * height * 4, NULL, GLEXT_GL_STREAM_DRAW));
+            m_buffers[i] = static_cast<unsigned int>(buffer);
+        }
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+        return true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Pixel buffers are not supported: stage the pixels in client memory
+    m_pixels.resize(width * height * 4);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* StreamingTexture::map()
+{
+    if (m_mapped)
+        return m_mapped;
+
+    if (m_buffers.empty())
+    {
+        m_mapped = m_pixels.empty() ? NULL : &m_pixels[0];
+        return m_mapped;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // With enough buffers in the ring the transfer that last read this one is
+    // complete, otherwise the driver waits for it
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[m_current]));
+    m_mapped = static_cast<Uint8*>(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+#endif // SFML_OPENGL_ES
+
+    return m_mapped;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::commit()
+{
+    if (!m_mapped)
+        return;
+
+    m_mapped = NULL;
+
+    if (m_buffers.empty())
+    {
+        m_texture.update(&m_pixels[0]);
+        return;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // The texture is updated from the buffer, the driver schedules the transfer
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[m_current]));
+    if (GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER))
+        m_texture.updateFromPixelBuffer();
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    m_current = (m_current + 1) % m_buffers.size();
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::setSmooth(bool smooth)
+{
+    m_texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u StreamingTexture::getSize() const
+{
+    return m_texture.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& StreamingTexture::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::destroyBuffers()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_buffers.empty())
+    {
+        ensureGlContext();
+
+        // Release the mapping first, if any
+        if (m_mapped)
+        {
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[m_current]));
+            GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER);
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+        }
+
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            GLuint buffer = static_cast<GLuint>(m_buffers[i]);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_buffers.clear();
+    m_pixels.clear();
+    m_current = 0;
+    m_mapped  = NULL;
+}
+
+} // namespace sf
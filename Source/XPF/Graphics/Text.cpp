@@ -28,21 +28,48 @@
 #include <XPF/Graphics/Text.hpp>
 #include <XPF/Graphics/Texture.hpp>
 #include <XPF/Graphics/RenderTarget.hpp>
+#include <algorithm>
 #include <cmath>
 
 
+namespace
+{
+    // Add an underline or strike-through line to the vertex array
+    void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness)
+    {
+        float top    = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+        float bottom = top + std::floor(thickness + 0.5f);
+
+        vertices.append(sf::Vertex(sf::Vector2f(0,          top),    color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(lineLength, top),    color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(0,          bottom), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(0,          bottom), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(lineLength, top),    color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(lineLength, bottom), color, sf::Vector2f(1, 1)));
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Text::Text() :
-m_string            (),
-m_font              (NULL),
-m_characterSize     (30),
-m_style             (Regular),
-m_color             (255, 255, 255),
-m_vertices          (Triangles),
-m_bounds            (),
-m_geometryNeedUpdate(false)
+m_string               (),
+m_font                 (NULL),
+m_characterSize        (30),
+m_style                (Regular),
+m_color                (255, 255, 255),
+m_vertices             (1, VertexArray(Triangles)),
+m_decorations          (Triangles),
+m_bounds               (),
+m_geometryNeedUpdate   (true),
+m_decorationsNeedUpdate(true),
+m_laidOutCount         (0),
+m_pen                  (),
+m_previousChar         (0),
+m_boundsMin            (),
+m_boundsMax            (),
+m_lineEnds             ()
 {
 
 }
@@ -50,14 +77,22 @@ m_geometryNeedUpdate(false)
 
 ////////////////////////////////////////////////////////////
 Text::Text(const String& string, const Font& font, unsigned int characterSize) :
-m_string            (string),
-m_font              (&font),
-m_characterSize     (characterSize),
-m_style             (Regular),
-m_color             (255, 255, 255),
-m_vertices          (Triangles),
-m_bounds            (),
-m_geometryNeedUpdate(true)
+m_string               (string),
+m_font                 (&font),
+m_characterSize        (characterSize),
+m_style                (Regular),
+m_color                (255, 255, 255),
+m_vertices             (1, VertexArray(Triangles)),
+m_decorations          (Triangles),
+m_bounds               (),
+m_geometryNeedUpdate   (true),
+m_decorationsNeedUpdate(true),
+m_laidOutCount         (0),
+m_pen                  (),
+m_previousChar         (0),
+m_boundsMin            (),
+m_boundsMax            (),
+m_lineEnds             ()
 {
 
 }
@@ -68,8 +103,14 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // If the current string is a prefix of the new one, the characters
+        // already laid out are kept and only the new ones will be added
+        bool appended = (string.getSize() > m_string.getSize()) &&
+                        std::equal(m_string.begin(), m_string.end(), string.begin());
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        if (!appended)
+            m_geometryNeedUpdate = true;
     }
 }
 
@@ -101,8 +142,13 @@ void Text::setStyle(Uint32 style)
 {
     if (m_style != style)
     {
+        // Underline and strike-through only affect the lines, not the characters
+        if ((m_style ^ style) & (Bold | Italic))
+            m_geometryNeedUpdate = true;
+        else
+            m_decorationsNeedUpdate = true;
+
         m_style = style;
-        m_geometryNeedUpdate = true;
     }
 }
 
@@ -118,8 +164,11 @@ void Text::setColor(const Color& color)
         // (if geometry is updated anyway, we can skip this step)
         if (!m_geometryNeedUpdate)
         {
-            for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
-                m_vertices[i].color = m_color;
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
+                for (std::size_t j = 0; j < m_vertices[i].getVertexCount(); ++j)
+                    m_vertices[i][j].color = m_color;
+            for (std::size_t i = 0; i < m_decorations.getVertexCount(); ++i)
+                m_decorations[i].color = m_color;
         }
     }
 }
@@ -230,8 +279,27 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
-        target.draw(m_vertices, states);
+
+        // Skip the text if it is outside the view
+        if (target.isCullingEnabled() && target.isCulled(m_bounds, states.transform))
+            return;
+
+        // Draw the glyphs of each font page with the page's texture
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            if (m_vertices[i].getVertexCount() > 0)
+            {
+                states.texture = &m_font->getTexture(m_characterSize, static_cast<unsigned int>(i));
+                target.draw(m_vertices[i], states);
+            }
+        }
+
+        // The lines use the white square of the first page
+        if (m_decorations.getVertexCount() > 0)
+        {
+            states.texture = &m_font->getTexture(m_characterSize, 0);
+            target.draw(m_decorations, states);
+        }
     }
 }
 
@@ -239,173 +307,171 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
-    // Do nothing, if geometry has not changed
-    if (!m_geometryNeedUpdate)
-        return;
-
-    // Mark geometry as updated
-    m_geometryNeedUpdate = false;
-
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = FloatRect();
-
-    // No font: nothing to draw
-    if (!m_font)
-        return;
+    // If the whole geometry is invalid, start again from the first character
+    if (m_geometryNeedUpdate)
+    {
+        m_geometryNeedUpdate = false;
+
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+            m_vertices[i].clear();
+        m_lineEnds.clear();
+
+        m_laidOutCount          = 0;
+        m_pen                   = Vector2f(0.f, static_cast<float>(m_characterSize));
+        m_previousChar          = 0;
+        m_boundsMin             = Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize));
+        m_boundsMax             = Vector2f(0.f, 0.f);
+        m_decorationsNeedUpdate = true;
+    }
 
-    // No text: nothing to draw
-    if (m_string.isEmpty())
+    // No font or no text: nothing to draw
+    if (!m_font || m_string.isEmpty())
+    {
+        m_decorations.clear();
+        m_decorationsNeedUpdate = false;
+        m_bounds = FloatRect();
         return;
+    }
 
-    // Compute values related to the text style
-    bool  bold               = (m_style & Bold) != 0;
-    bool  underlined         = (m_style & Underlined) != 0;
-    bool  strikeThrough      = (m_style & StrikeThrough) != 0;
-    float italic             = (m_style & Italic) ? 0.208f : 0.f; // 12 degrees
-    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
-    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
-
-    // Compute the location of the strike through dynamically
-    // We use the center point of the lowercase 'x' glyph as the reference
-    // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
-    float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
-
-    // Precompute the variables needed by the algorithm
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
-
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    // Lay out the characters that are not yet (all of them after a full invalidation)
+    if (m_laidOutCount < m_string.getSize())
     {
-        Uint32 curChar = m_string[i];
-
-        // Apply the kerning offset
-        x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
-        prevChar = curChar;
-
-        // If we're using the underlined style and there's a new line, draw a line
-        if (underlined && (curChar == L'\n'))
+        // Compute values related to the text style
+        bool  bold   = (m_style & Bold) != 0;
+        float italic = (m_style & Italic) ? 0.208f : 0.f; // 12 degrees
+
+        // Precompute the variables needed by the algorithm
+        float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
+        float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+
+        // Resume from where the previous layout stopped
+        float  x        = m_pen.x;
+        float  y        = m_pen.y;
+        float  minX     = m_boundsMin.x;
+        float  minY     = m_boundsMin.y;
+        float  maxX     = m_boundsMax.x;
+        float  maxY     = m_boundsMax.y;
+        Uint32 prevChar = m_previousChar;
+
+        // Create one quad for each character
+        for (std::size_t i = m_laidOutCount; i < m_string.getSize(); ++i)
         {
-            float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+            Uint32 curChar = m_string[i];
 
-        // If we're using the strike through style and there's a new line, draw a line across all characters
-        if (strikeThrough && (curChar == L'\n'))
-        {
-            float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+            // Apply the kerning offset
+            x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
+            prevChar = curChar;
 
-        // Handle special characters
-        if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
-        {
-            // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
+            // Remember where each line ends, for the underline and strike-through lines
+            if (curChar == L'\n')
+                m_lineEnds.push_back(Vector2f(x, y));
 
-            switch (curChar)
+            // Handle special characters
+            if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
             {
-                case ' ':  x += hspace;        break;
-                case '\t': x += hspace * 4;    break;
-                case '\n': y += vspace; x = 0; break;
+                // Update the current bounds (min coordinates)
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+
+                switch (curChar)
+                {
+                    case ' ':  x += hspace;        break;
+                    case '\t': x += hspace * 4;    break;
+                    case '\n': y += vspace; x = 0; break;
+                }
+
+                // Update the current bounds (max coordinates)
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+
+                // Next glyph, no need to create a quad for whitespace
+                continue;
             }
 
-            // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
-
-            // Next glyph, no need to create a quad for whitespace
-            continue;
+            // Extract the current glyph's description
+            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+
+            float left   = glyph.bounds.left;
+            float top    = glyph.bounds.top;
+            float right  = glyph.bounds.left + glyph.bounds.width;
+            float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+            float u1 = static_cast<float>(glyph.textureRect.left);
+            float v1 = static_cast<float>(glyph.textureRect.top);
+            float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+            float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+            // Add a quad for the current character, into the vertices of its font page
+            if (glyph.page >= m_vertices.size())
+                m_vertices.resize(glyph.page + 1, VertexArray(Triangles));
+            VertexArray& vertices = m_vertices[glyph.page];
+
+            vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
+            vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
+            vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
+            vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
+            vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
+            vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
+
+            // Update the current bounds
+            minX = std::min(minX, x + left - italic * bottom);
+            maxX = std::max(maxX, x + right - italic * top);
+            minY = std::min(minY, y + top);
+            maxY = std::max(maxY, y + bottom);
+
+            // Advance to the next character
+            x += glyph.advance;
         }
 
-        // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
-
-        float left   = glyph.bounds.left;
-        float top    = glyph.bounds.top;
-        float right  = glyph.bounds.left + glyph.bounds.width;
-        float bottom = glyph.bounds.top  + glyph.bounds.height;
-
-        float u1 = static_cast<float>(glyph.textureRect.left);
-        float v1 = static_cast<float>(glyph.textureRect.top);
-        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
-        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
-
-        // Add a quad for the current character
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
-
-        // Update the current bounds
-        minX = std::min(minX, x + left - italic * bottom);
-        maxX = std::max(maxX, x + right - italic * top);
-        minY = std::min(minY, y + top);
-        maxY = std::max(maxY, y + bottom);
-
-        // Advance to the next character
-        x += glyph.advance;
-    }
+        // Save the state of the layout, so that appended characters can resume from it
+        m_laidOutCount = m_string.getSize();
+        m_pen          = Vector2f(x, y);
+        m_previousChar = prevChar;
+        m_boundsMin    = Vector2f(minX, minY);
+        m_boundsMax    = Vector2f(maxX, maxY);
 
-    // If we're using the underlined style, add the last line
-    if (underlined)
-    {
-        float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+        // The last line changed: its underline and strike-through must follow
+        m_decorationsNeedUpdate = true;
     }
 
-    // If we're using the strike through style, add the last line across all characters
-    if (strikeThrough)
+    // Rebuild the underline and strike-through lines
+    if (m_decorationsNeedUpdate)
     {
-        float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+        m_decorationsNeedUpdate = false;
+        m_decorations.clear();
+
+        bool underlined    = (m_style & Underlined) != 0;
+        bool strikeThrough = (m_style & StrikeThrough) != 0;
+        if (underlined || strikeThrough)
+        {
+            bool  bold               = (m_style & Bold) != 0;
+            float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
+            float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+
+            // Compute the location of the strike through dynamically
+            // We use the center point of the lowercase 'x' glyph as the reference
+            // We reuse the underline thickness as the thickness of the strike through as well
+            FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
+            float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+            // Add the lines of each finished line, then of the current one
+            for (std::size_t i = 0; i <= m_lineEnds.size(); ++i)
+            {
+                const Vector2f& end = (i < m_lineEnds.size()) ? m_lineEnds[i] : m_pen;
+
+                if (underlined)
+                    addLine(m_decorations, end.x, end.y, m_color, underlineOffset, underlineThickness);
+                if (strikeThrough)
+                    addLine(m_decorations, end.x, end.y, m_color, strikeThroughOffset, underlineThickness);
+            }
+        }
     }
 
     // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+    m_bounds.left   = m_boundsMin.x;
+    m_bounds.top    = m_boundsMin.y;
+    m_bounds.width  = m_boundsMax.x - m_boundsMin.x;
+    m_bounds.height = m_boundsMax.y - m_boundsMin.y;
 }
 
 } // namespace sf
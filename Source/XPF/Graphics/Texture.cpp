@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <XPF/Graphics/Texture.hpp>
 #include <XPF/Graphics/Image.hpp>
+#include <XPF/Graphics/ImageReadback.hpp>
 #include <XPF/Graphics/GLCheck.hpp>
 #include <XPF/Graphics/TextureSaver.hpp>
 #include <XPF/Window/Context.hpp>
@@ -378,6 +379,40 @@ Image Texture::copyToImage() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::copyToImageAsync(ImageReadback& readback) const
+{
+    // Easy case: empty texture
+    if (!m_texture)
+        return false;
+
+    // Fall back to a synchronous copy if pixel buffers are not supported
+    if (!ImageReadback::isAvailable())
+    {
+        readback.setImage(copyToImage());
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // The whole texture is read into the pixel buffer, padding and flipping
+    // are handled when the image is retrieved
+    readback.beginRead(m_size, m_actualSize, m_pixelsFlipped);
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    readback.endRead();
+
+#endif // SFML_OPENGL_ES
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels)
 {
@@ -408,6 +443,25 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::updateFromPixelBuffer()
+{
+    if (m_texture)
+    {
+        ensureGlContext();
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // A null pointer is an offset in the bound pixel buffer
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image)
 {
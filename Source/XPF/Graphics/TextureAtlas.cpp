@@ -0,0 +1,393 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/TextureAtlas.hpp>
+#include <XPF/System/Err.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+namespace
+{
+    // Largest page created by the atlas
+    const unsigned int maxPageSize = 4096;
+
+    // Version written in the layout files
+    const char* layoutHeader = "XPF texture atlas 1";
+
+    // Sort pending images by decreasing height, then decreasing width
+    struct HeightOrder
+    {
+        HeightOrder(const std::vector<std::pair<std::string, sf::Image> >& images) : images(images) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            sf::Vector2u leftSize  = images[left].second.getSize();
+            sf::Vector2u rightSize = images[right].second.getSize();
+            if (leftSize.y != rightSize.y)
+                return leftSize.y > rightSize.y;
+            return leftSize.x > rightSize.x;
+        }
+
+        const std::vector<std::pair<std::string, sf::Image> >& images;
+    };
+
+    // Position of a pending image in the pages being packed
+    struct Placement
+    {
+        std::size_t  image;
+        std::size_t  page;
+        unsigned int x;
+        unsigned int y;
+    };
+
+    // Get the file name of the page of an atlas
+    std::string getPageFilename(const std::string& filename, std::size_t page)
+    {
+        std::ostringstream stream;
+        stream << filename << "." << page << ".png";
+        return stream.str();
+    }
+
+    // Get the directory part of a path, including the trailing separator
+    std::string getDirectory(const std::string& filename)
+    {
+        std::string::size_type separator = filename.find_last_of("/\\");
+        return separator != std::string::npos ? filename.substr(0, separator + 1) : std::string();
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle::Handle() :
+texture    (NULL),
+textureRect()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas() :
+m_pending(),
+m_pages  (),
+m_regions(),
+m_smooth (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addFromFile(const std::string& name, const std::string& filename)
+{
+    Image image;
+    return image.loadFromFile(filename) && addFromImage(name, image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addFromMemory(const std::string& name, const void* data, std::size_t size)
+{
+    Image image;
+    return image.loadFromMemory(data, size) && addFromImage(name, image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addFromStream(const std::string& name, InputStream& stream)
+{
+    Image image;
+    return image.loadFromStream(stream) && addFromImage(name, image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addFromImage(const std::string& name, const Image& image)
+{
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+    {
+        err() << "Failed to add image \"" << name << "\" to texture atlas, the image is empty" << std::endl;
+        return false;
+    }
+
+    m_pending.push_back(std::make_pair(name, image));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::pack(unsigned int padding)
+{
+    if (m_pending.empty())
+        return true;
+
+    bool success = true;
+    unsigned int maxSize = std::min(Texture::getMaximumSize(), maxPageSize);
+
+    // Sort the images by height, so that each row holds images of similar heights
+    std::vector<std::size_t> order(m_pending.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), HeightOrder(m_pending));
+
+    // Place the images in rows, and start a new page when the current one is full
+    std::vector<Placement> placements;
+    std::vector<Vector2u> pageSizes;
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int rowHeight = 0;
+    for (std::vector<std::size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
+    {
+        Vector2u size = m_pending[*it].second.getSize();
+        if ((size.x > maxSize) || (size.y > maxSize))
+        {
+            err() << "Failed to pack image \"" << m_pending[*it].first << "\" in texture atlas, its size ("
+                  << size.x << "x" << size.y << ") is greater than the maximum page size ("
+                  << maxSize << "x" << maxSize << ")" << std::endl;
+            success = false;
+            continue;
+        }
+
+        if (pageSizes.empty())
+            pageSizes.push_back(Vector2u(0, 0));
+
+        if (x + size.x > maxSize)
+        {
+            x = 0;
+            y += rowHeight + padding;
+            rowHeight = 0;
+        }
+
+        if (y + size.y > maxSize)
+        {
+            pageSizes.push_back(Vector2u(0, 0));
+            x = 0;
+            y = 0;
+            rowHeight = 0;
+        }
+
+        Placement placement = {*it, pageSizes.size() - 1, x, y};
+        placements.push_back(placement);
+
+        Vector2u& pageSize = pageSizes.back();
+        pageSize.x = std::max(pageSize.x, x + size.x);
+        pageSize.y = std::max(pageSize.y, y + size.y);
+
+        x += size.x + padding;
+        rowHeight = std::max(rowHeight, size.y);
+    }
+
+    // Compose the pages and upload them; placements are already ordered by page
+    std::vector<Placement>::const_iterator placement = placements.begin();
+    for (std::size_t page = 0; page < pageSizes.size(); ++page)
+    {
+        Image pixels;
+        pixels.create(pageSizes[page].x, pageSizes[page].y, Color(255, 255, 255, 0));
+
+        std::vector<Placement>::const_iterator first = placement;
+        for (; (placement != placements.end()) && (placement->page == page); ++placement)
+            pixels.copy(m_pending[placement->image].second, placement->x, placement->y);
+
+        m_pages.push_back(Texture());
+        if (!m_pages.back().loadFromImage(pixels))
+        {
+            m_pages.pop_back();
+            success = false;
+            continue;
+        }
+        m_pages.back().setSmooth(m_smooth);
+
+        for (std::vector<Placement>::const_iterator it = first; it != placement; ++it)
+        {
+            const std::pair<std::string, Image>& image = m_pending[it->image];
+            Region region = {m_pages.size() - 1, IntRect(it->x, it->y, image.second.getSize().x, image.second.getSize().y)};
+            m_regions[image.first] = region;
+        }
+    }
+
+    m_pending.clear();
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::saveToFile(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str(), std::ios_base::trunc);
+    if (!file)
+    {
+        err() << "Failed to save texture atlas \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    // Page images are referenced relatively to the layout file
+    std::string directory = getDirectory(filename);
+    std::string basename = filename.substr(directory.size());
+
+    file << layoutHeader << "\n" << m_pages.size() << "\n";
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        if (!m_pages[i].copyToImage().saveToFile(getPageFilename(filename, i)))
+            return false;
+
+        file << getPageFilename(basename, i) << "\n";
+    }
+
+    file << m_regions.size() << "\n";
+    for (RegionTable::const_iterator it = m_regions.begin(); it != m_regions.end(); ++it)
+    {
+        const IntRect& rect = it->second.rect;
+        file << it->second.page << " " << rect.left << " " << rect.top << " " << rect.width << " " << rect.height << " " << it->first << "\n";
+    }
+
+    if (!file)
+    {
+        err() << "Failed to save texture atlas \"" << filename << "\" (write error)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::loadFromFile(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file)
+    {
+        err() << "Failed to load texture atlas \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    std::size_t pageCount = 0;
+    if (!std::getline(file, line) || (line != layoutHeader) || !(file >> pageCount) || !std::getline(file, line))
+    {
+        err() << "Failed to load texture atlas \"" << filename << "\" (invalid header)" << std::endl;
+        return false;
+    }
+
+    // Load the pages after the existing ones, and remove them if anything fails
+    std::string directory = getDirectory(filename);
+    std::size_t firstPage = m_pages.size();
+    bool success = true;
+    for (std::size_t i = 0; success && (i < pageCount); ++i)
+    {
+        m_pages.push_back(Texture());
+        success = std::getline(file, line) && m_pages.back().loadFromFile(directory + line);
+        m_pages.back().setSmooth(m_smooth);
+    }
+
+    // Read the regions; the name is the end of the line, so that it can contain spaces
+    RegionTable regions;
+    std::size_t regionCount = 0;
+    if (success && (file >> regionCount))
+    {
+        for (std::size_t i = 0; success && (i < regionCount); ++i)
+        {
+            Region region;
+            std::string name;
+            success = (file >> region.page >> region.rect.left >> region.rect.top >> region.rect.width >> region.rect.height)
+                      && (file.get() == ' ') && std::getline(file, name) && (region.page < pageCount);
+
+            region.page += firstPage;
+            regions[name] = region;
+        }
+    }
+    else
+    {
+        success = false;
+    }
+
+    if (!success)
+    {
+        err() << "Failed to load texture atlas \"" << filename << "\" (invalid layout or missing page)" << std::endl;
+        m_pages.resize(firstPage);
+        return false;
+    }
+
+    for (RegionTable::const_iterator it = regions.begin(); it != regions.end(); ++it)
+        m_regions[it->first] = it->second;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::getHandle(const std::string& name) const
+{
+    Handle handle;
+
+    RegionTable::const_iterator it = m_regions.find(name);
+    if (it != m_regions.end())
+    {
+        handle.texture     = &m_pages[it->second.page];
+        handle.textureRect = it->second.rect;
+    }
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getPage(std::size_t index) const
+{
+    return m_pages[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_smooth = smooth;
+
+    for (std::deque<Texture>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        it->setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    m_pending.clear();
+    m_pages.clear();
+    m_regions.clear();
+}
+
+} // namespace sf
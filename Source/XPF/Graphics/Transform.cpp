@@ -26,7 +26,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <XPF/Graphics/Transform.hpp>
+#include <XPF/Graphics/Vertex.hpp>
+#include <XPF/Graphics/VertexTransform.hpp>
 #include <cmath>
+#include <cstring>
 
 
 namespace sf
@@ -113,13 +116,14 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
     // Transform the 4 corners of the rectangle
-    const Vector2f points[] =
+    Vector2f points[] =
     {
-        transformPoint(rectangle.left, rectangle.top),
-        transformPoint(rectangle.left, rectangle.top + rectangle.height),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
+        Vector2f(rectangle.left, rectangle.top),
+        Vector2f(rectangle.left, rectangle.top + rectangle.height),
+        Vector2f(rectangle.left + rectangle.width, rectangle.top),
+        Vector2f(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
     };
+    transformPoints(points, points, 4);
 
     // Compute the bounding rectangle of the transformed points
     float left = points[0].x;
@@ -138,6 +142,25 @@ FloatRect Transform::transformRect(const FloatRect& rectangle) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const
+{
+    priv::transformPositions(m_matrix, points, result, count, sizeof(Vector2f));
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformVertices(const Vertex* vertices, Vertex* result, std::size_t count) const
+{
+    // Copy the colors and texture coordinates, then overwrite the positions
+    // (the position is the first member of sf::Vertex)
+    if (result != vertices)
+        std::memcpy(result, vertices, count * sizeof(Vertex));
+
+    priv::transformPositions(m_matrix, vertices, result, count, sizeof(Vertex));
+}
+
+
 ////////////////////////////////////////////////////////////
 Transform& Transform::combine(const Transform& transform)
 {
@@ -143,8 +143,15 @@ FloatRect VertexArray::getBounds() const
 ////////////////////////////////////////////////////////////
 void VertexArray::draw(RenderTarget& target, RenderStates states) const
 {
-    if (!m_vertices.empty())
-        target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+    if (m_vertices.empty())
+        return;
+
+    // Skip the array if it is outside the view; the bounds are not cached, since
+    // the vertices can be modified through references returned by operator []
+    if (target.isCullingEnabled() && target.isCulled(getBounds(), states.transform))
+        return;
+
+    target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
 }
 
 } // namespace sf
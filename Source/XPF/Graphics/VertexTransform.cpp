@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/VertexTransform.hpp>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+    #define SFML_VERTEXTRANSFORM_SSE2
+    #include <emmintrin.h>
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+
+    // The AVX kernel mixes 128 and 256-bit instructions, which is only efficient if
+    // all of them are VEX-encoded: GCC and clang do that in functions targeting AVX,
+    // Visual C++ only when the whole project is compiled with /arch:AVX or /arch:AVX2
+    #if defined(__GNUC__) || defined(__AVX__)
+        #define SFML_VERTEXTRANSFORM_AVX
+    #endif
+
+    // GCC and clang only emit SSE2/AVX instructions in functions explicitly targeting them
+    #if defined(__GNUC__)
+        #define SFML_TARGET(features) __attribute__((target(features)))
+    #else
+        #define SFML_TARGET(features)
+    #endif
+
+#endif
+
+
+namespace
+{
+    typedef void (*TransformFunction)(const float*, const char*, char*, std::size_t, std::size_t);
+
+    // Reference implementation, one position at a time (same formula as sf::Transform::transformPoint)
+    void transformScalar(const float* m, const char* input, char* output, std::size_t count, std::size_t stride)
+    {
+        for (std::size_t i = 0; i < count; ++i, input += stride, output += stride)
+        {
+            const float* in  = reinterpret_cast<const float*>(input);
+            float*       out = reinterpret_cast<float*>(output);
+
+            float x = in[0];
+            float y = in[1];
+            out[0] = m[0] * x + m[4] * y + m[12];
+            out[1] = m[1] * x + m[5] * y + m[13];
+        }
+    }
+
+#ifdef SFML_VERTEXTRANSFORM_SSE2
+
+    // Two positions per iteration: the register holds [x0 y0 x1 y1], and the result is
+    // [x0 y0 x1 y1] * [a e a e] + [y0 x0 y1 x1] * [b d b d] + [c f c f], which performs
+    // exactly the same operations as the scalar version
+    SFML_TARGET("sse2")
+    void transformSSE2(const float* m, const char* input, char* output, std::size_t count, std::size_t stride)
+    {
+        const __m128 diagonal    = _mm_setr_ps(m[0],  m[5],  m[0],  m[5]);
+        const __m128 crossed     = _mm_setr_ps(m[4],  m[1],  m[4],  m[1]);
+        const __m128 translation = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2, input += 2 * stride, output += 2 * stride)
+        {
+            __m128 points  = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(input));
+            points         = _mm_loadh_pi(points, reinterpret_cast<const __m64*>(input + stride));
+            __m128 swapped = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 result  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(points, diagonal), _mm_mul_ps(swapped, crossed)), translation);
+
+            _mm_storel_pi(reinterpret_cast<__m64*>(output), result);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(output + stride), result);
+        }
+
+        transformScalar(m, input, output, count - i, stride);
+    }
+
+#endif
+
+#ifdef SFML_VERTEXTRANSFORM_AVX
+
+    // Four positions per iteration, same operations as the SSE2 version on 256-bit registers
+    SFML_TARGET("avx")
+    void transformAVX(const float* m, const char* input, char* output, std::size_t count, std::size_t stride)
+    {
+        const __m256 diagonal    = _mm256_setr_ps(m[0],  m[5],  m[0],  m[5],  m[0],  m[5],  m[0],  m[5]);
+        const __m256 crossed     = _mm256_setr_ps(m[4],  m[1],  m[4],  m[1],  m[4],  m[1],  m[4],  m[1]);
+        const __m256 translation = _mm256_setr_ps(m[12], m[13], m[12], m[13], m[12], m[13], m[12], m[13]);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4, input += 4 * stride, output += 4 * stride)
+        {
+            __m128 first   = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(input));
+            first          = _mm_loadh_pi(first, reinterpret_cast<const __m64*>(input + stride));
+            __m128 second  = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(input + 2 * stride));
+            second         = _mm_loadh_pi(second, reinterpret_cast<const __m64*>(input + 3 * stride));
+            __m256 points  = _mm256_insertf128_ps(_mm256_castps128_ps256(first), second, 1);
+            __m256 swapped = _mm256_permute_ps(points, _MM_SHUFFLE(2, 3, 0, 1));
+            __m256 result  = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(points, diagonal), _mm256_mul_ps(swapped, crossed)), translation);
+
+            __m128 low  = _mm256_castps256_ps128(result);
+            __m128 high = _mm256_extractf128_ps(result, 1);
+            _mm_storel_pi(reinterpret_cast<__m64*>(output), low);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(output + stride), low);
+            _mm_storel_pi(reinterpret_cast<__m64*>(output + 2 * stride), high);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(output + 3 * stride), high);
+        }
+
+        // Avoid the penalty of switching back to SSE code with dirty upper registers
+        _mm256_zeroupper();
+
+        transformScalar(m, input, output, count - i, stride);
+    }
+
+#endif
+
+#ifdef SFML_VERTEXTRANSFORM_SSE2
+
+    // Query the CPU features (function 'leaf', sub-function 0)
+    void cpuid(unsigned int info[4], unsigned int leaf)
+    {
+    #if defined(_MSC_VER)
+        int registers[4];
+        __cpuidex(registers, static_cast<int>(leaf), 0);
+        for (int i = 0; i < 4; ++i)
+            info[i] = static_cast<unsigned int>(registers[i]);
+    #else
+        __cpuid_count(leaf, 0, info[0], info[1], info[2], info[3]);
+    #endif
+    }
+
+#endif
+
+#ifdef SFML_VERTEXTRANSFORM_AVX
+
+    // Check whether the OS saves the AVX registers on context switches
+    bool isAvxStateEnabled()
+    {
+    #if defined(_MSC_VER)
+        return (_xgetbv(0) & 6) == 6;
+    #else
+        unsigned int eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (eax & 6) == 6;
+    #endif
+    }
+
+#endif
+
+    // Select the fastest implementation supported by the CPU
+    TransformFunction selectTransformFunction()
+    {
+    #ifdef SFML_VERTEXTRANSFORM_SSE2
+
+        unsigned int info[4];
+        cpuid(info, 1);
+        bool sse2    = (info[3] & (1 << 26)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx     = (info[2] & (1 << 28)) != 0;
+
+        #ifdef SFML_VERTEXTRANSFORM_AVX
+            if (osxsave && avx && isAvxStateEnabled())
+                return &transformAVX;
+        #else
+            (void)osxsave;
+            (void)avx;
+        #endif
+
+        if (sse2)
+            return &transformSSE2;
+
+    #endif
+
+        return &transformScalar;
+    }
+
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void transformPositions(const float* matrix, const void* input, void* output, std::size_t count, std::size_t stride)
+{
+    // Selected on first use rather than at static initialization time,
+    // so that static initializers of other translation units can use it
+    static const TransformFunction transformFunction = selectTransformFunction();
+
+    transformFunction(matrix, static_cast<const char*>(input), static_cast<char*>(output), count, stride);
+}
+
+} // namespace priv
+
+} // namespace sf
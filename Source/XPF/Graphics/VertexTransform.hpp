@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VERTEXTRANSFORM_HPP
+#define SFML_VERTEXTRANSFORM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Transform an array of 2D positions with a 4x4 matrix
+///
+/// The positions are pairs of floats separated by \a stride
+/// bytes, so that both plain arrays of points and the
+/// position member of an array of vertices can be processed.
+/// \a input and \a output may be the same array.
+///
+/// The implementation (scalar, SSE2 or AVX) is selected on
+/// first use from the features of the CPU; all of them give
+/// the same results as sf::Transform::transformPoint.
+///
+/// \param matrix Transform matrix (16 floats, as returned by sf::Transform::getMatrix)
+/// \param input  Address of the first position to read
+/// \param output Address of the first position to write
+/// \param count  Number of positions
+/// \param stride Distance between two consecutive positions, in bytes
+///
+////////////////////////////////////////////////////////////
+void transformPositions(const float* matrix, const void* input, void* output, std::size_t count, std::size_t stride);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXTRANSFORM_HPP
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/System/FramePacer.hpp>
+
+#if defined(XPF_SYSTEM_WINDOWS)
+    #include <XPF/System/Win32/ClockImpl.hpp>
+    #include <XPF/System/Win32/SleepImpl.hpp>
+#else
+    #include <XPF/System/Unix/ClockImpl.hpp>
+    #include <XPF/System/Unix/SleepImpl.hpp>
+#endif
+
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FramePacer::FramePacer() :
+m_frameTime      (Time::Zero),
+m_spinThreshold  (milliseconds(2)),
+m_deadline       (Time::Zero),
+m_frameStart     (Time::Zero),
+m_callback       (NULL),
+m_userData       (NULL),
+m_resolution     (microseconds(250)),
+m_histogram      (200, 0),
+m_frameCount     (0),
+m_missedDeadlines(0)
+{
+    restart();
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFrameTime(Time frameTime)
+{
+    m_frameTime = frameTime;
+    restart();
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getFrameTime() const
+{
+    return m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setSpinThreshold(Time threshold)
+{
+    m_spinThreshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setMissedDeadlineCallback(MissedDeadlineCallback callback, void* userData)
+{
+    m_callback = callback;
+    m_userData = userData;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::wait()
+{
+    Time now = priv::ClockImpl::getCurrentTime();
+
+    if (m_frameTime > Time::Zero)
+    {
+        if (now < m_deadline)
+        {
+            // Sleep until shortly before the deadline, since the
+            // scheduler may wake us up later than requested...
+            if (m_deadline - now > m_spinThreshold)
+                priv::sleepUntilImpl(m_deadline - m_spinThreshold);
+
+            // ... then spin until the deadline is reached
+            do
+            {
+                now = priv::ClockImpl::getCurrentTime();
+            }
+            while (now < m_deadline);
+
+            m_deadline += m_frameTime;
+        }
+        else
+        {
+            m_missedDeadlines++;
+
+            if (m_callback)
+                m_callback(now - m_frameStart, now - m_deadline, m_userData);
+
+            // Don't render a burst of frames to catch up with a long stall
+            if (now - m_deadline > m_frameTime)
+                m_deadline = now + m_frameTime;
+            else
+                m_deadline += m_frameTime;
+        }
+    }
+
+    // Record the duration of the frame which just ended
+    Time frameTime = now - m_frameStart;
+    std::size_t bucket = static_cast<std::size_t>(frameTime.asMicroseconds() / m_resolution.asMicroseconds());
+    if (bucket >= m_histogram.size())
+        bucket = m_histogram.size() - 1;
+
+    m_histogram[bucket]++;
+    m_frameCount++;
+    m_frameStart = now;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::restart()
+{
+    m_frameStart = priv::ClockImpl::getCurrentTime();
+    m_deadline = m_frameStart + m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setHistogramRange(Time resolution, std::size_t bucketCount)
+{
+    // A bucket must be at least one microsecond wide, and there must be at least one
+    m_resolution = (resolution.asMicroseconds() > 0) ? resolution : microseconds(1);
+    m_histogram.assign(bucketCount > 0 ? bucketCount : 1, 0);
+
+    clearStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getHistogramResolution() const
+{
+    return m_resolution;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Uint64>& FramePacer::getHistogram() const
+{
+    return m_histogram;
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getFrameTimePercentile(float percentile) const
+{
+    if (m_frameCount == 0)
+        return Time::Zero;
+
+    // Find the first bucket where the cumulated count reaches the requested fraction
+    Uint64 target = static_cast<Uint64>(m_frameCount * (percentile / 100.f) + 0.5f);
+    Uint64 count = 0;
+
+    for (std::size_t i = 0; i < m_histogram.size(); ++i)
+    {
+        count += m_histogram[i];
+        if ((count >= target) && (count > 0))
+            return m_resolution * static_cast<Int64>(i + 1);
+    }
+
+    return m_resolution * static_cast<Int64>(m_histogram.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FramePacer::getFrameCount() const
+{
+    return m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FramePacer::getMissedDeadlineCount() const
+{
+    return m_missedDeadlines;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::clearStatistics()
+{
+    std::fill(m_histogram.begin(), m_histogram.end(), 0);
+    m_frameCount = 0;
+    m_missedDeadlines = 0;
+}
+
+} // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Unix/SleepImpl.hpp>
+#include <SFML/System/Unix/ClockImpl.hpp>
 #include <errno.h>
 #include <time.h>
 
@@ -54,6 +55,39 @@ void sleepImpl(Time time)
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline)
+{
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    // There's no absolute sleep on Mac OS X, wait for the remaining time instead
+    Time remaining = deadline - ClockImpl::getCurrentTime();
+    if (remaining > Time::Zero)
+        sleepImpl(remaining);
+
+#else
+
+    if (deadline <= Time::Zero)
+        return;
+
+    // The deadline is on the monotonic clock used by ClockImpl, so waking up
+    // late or being interrupted doesn't push the next deadlines back
+    Uint64 usecs = deadline.asMicroseconds();
+
+    timespec ti;
+    ti.tv_nsec = (usecs % 1000000) * 1000;
+    ti.tv_sec = usecs / 1000000;
+
+    // Unlike nanosleep, clock_nanosleep returns the error code; when it
+    // is interrupted, the same absolute deadline can simply be reused
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ti, NULL) == EINTR)
+    {
+    }
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -44,6 +44,14 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void sleepImpl(Time time);
 
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of an absolute sleep
+///
+/// \param deadline Time to wake up at, in the time base of ClockImpl
+///
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline);
+
 } // namespace priv
 
 } // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <XPF/System/Win32/SleepImpl.hpp>
+#include <XPF/System/Win32/ClockImpl.hpp>
 #include <windows.h>
 
 #pragma comment(lib,"winmm.lib")
@@ -51,6 +52,16 @@ void sleepImpl(Time time)
     timeEndPeriod(tc.wPeriodMin);
 }
 
+
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline)
+{
+    // Windows has no absolute sleep, wait for the remaining time instead
+    Time remaining = deadline - ClockImpl::getCurrentTime();
+    if (remaining > Time::Zero)
+        sleepImpl(remaining);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Window/ContextPool.hpp>
+#include <XPF/Window/GlContext.hpp>
+#include <XPF/System/Err.hpp>
+#include <XPF/System/Lock.hpp>
+#include <XPF/OpenGL.hpp>
+
+
+#if !defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
+#if !defined(GL_TIMEOUT_IGNORED)
+    #define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+#endif
+
+
+namespace
+{
+    // Same type as GLsync, which old OpenGL headers don't define
+    typedef struct __GLsync* SyncHandle;
+
+#if defined(XPF_SYSTEM_WINDOWS)
+
+    typedef SyncHandle (APIENTRY *glFenceSyncFuncType)(GLenum, GLbitfield);
+    typedef void (APIENTRY *glWaitSyncFuncType)(SyncHandle, GLbitfield, sf::Uint64);
+    typedef void (APIENTRY *glDeleteSyncFuncType)(SyncHandle);
+
+#else
+
+    typedef SyncHandle (*glFenceSyncFuncType)(GLenum, GLbitfield);
+    typedef void (*glWaitSyncFuncType)(SyncHandle, GLbitfield, sf::Uint64);
+    typedef void (*glDeleteSyncFuncType)(SyncHandle);
+
+#endif
+
+    // Fence functions (core since OpenGL 3.2), NULL if not supported
+    glFenceSyncFuncType  glFenceSyncFunc  = NULL;
+    glWaitSyncFuncType   glWaitSyncFunc   = NULL;
+    glDeleteSyncFuncType glDeleteSyncFunc = NULL;
+
+    // Load the fence functions, a context must be active
+    void loadSyncFunctions(const sf::ContextSettings& settings)
+    {
+        if ((settings.majorVersion < 3) || ((settings.majorVersion == 3) && (settings.minorVersion < 2)))
+            return;
+
+        glFenceSyncFunc  = reinterpret_cast<glFenceSyncFuncType>(sf::priv::GlContext::getFunction("glFenceSync"));
+        glWaitSyncFunc   = reinterpret_cast<glWaitSyncFuncType>(sf::priv::GlContext::getFunction("glWaitSync"));
+        glDeleteSyncFunc = reinterpret_cast<glDeleteSyncFuncType>(sf::priv::GlContext::getFunction("glDeleteSync"));
+
+        if (!glFenceSyncFunc || !glWaitSyncFunc || !glDeleteSyncFunc)
+            glFenceSyncFunc = NULL;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ContextPool::Lease::Lease(ContextPool& pool) :
+m_pool   (pool),
+m_context(pool.acquire())
+{
+    // Nothing to do
+}
+
+
+////////////////////////////////////////////////////////////
+ContextPool::Lease::~Lease()
+{
+    if (m_context)
+        m_pool.release(m_context);
+}
+
+
+////////////////////////////////////////////////////////////
+ContextPool::ContextPool(std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // The context is shared with all the others, and active after its creation
+        priv::GlContext* context = priv::GlContext::create();
+        m_contexts.push_back(context);
+
+        if (i == 0)
+            loadSyncFunctions(context->getSettings());
+
+        context->setActive(false);
+    }
+
+    m_available = m_contexts;
+}
+
+
+////////////////////////////////////////////////////////////
+ContextPool::~ContextPool()
+{
+    Lock lock(m_mutex);
+
+    if (m_available.size() != m_contexts.size())
+        err() << "Context pool destroyed while some of its contexts are still leased" << std::endl;
+
+    // Delete the fences nobody waited for
+    if (!m_fences.empty())
+    {
+        ensureGlContext();
+
+        for (std::vector<void*>::iterator it = m_fences.begin(); it != m_fences.end(); ++it)
+            glDeleteSyncFunc(static_cast<SyncHandle>(*it));
+    }
+
+    for (std::vector<priv::GlContext*>::iterator it = m_contexts.begin(); it != m_contexts.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ContextPool::getContextCount() const
+{
+    return m_contexts.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ContextPool::synchronize()
+{
+    std::vector<void*> fences;
+    {
+        Lock lock(m_mutex);
+        fences.swap(m_fences);
+    }
+
+    if (fences.empty())
+        return;
+
+    // The waits are queued on the context active in this thread
+    ensureGlContext();
+
+    for (std::vector<void*>::iterator it = fences.begin(); it != fences.end(); ++it)
+    {
+        SyncHandle fence = static_cast<SyncHandle>(*it);
+
+        glWaitSyncFunc(fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSyncFunc(fence);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+priv::GlContext* ContextPool::acquire()
+{
+    if (m_contexts.empty())
+    {
+        err() << "Failed to lease a context: the context pool is empty" << std::endl;
+        return NULL;
+    }
+
+    // Wait until a context is given back
+    priv::GlContext* context;
+    {
+        Lock lock(m_mutex);
+
+        while (m_available.empty())
+            m_released.wait(m_mutex);
+
+        context = m_available.back();
+        m_available.pop_back();
+    }
+
+    if (!context->setActive(true))
+        err() << "Failed to activate the leased context" << std::endl;
+
+    return context;
+}
+
+
+////////////////////////////////////////////////////////////
+void ContextPool::release(priv::GlContext* context)
+{
+    void* fence = NULL;
+
+    if (glFenceSyncFunc)
+    {
+        // The fence must be flushed for other contexts to be able to wait for it
+        fence = glFenceSyncFunc(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+    else
+    {
+        // Without fences, the commands must be complete before another context uses their results
+        glFinish();
+    }
+
+    // Don't leave an internal context active on this thread
+    if (!context->releaseCurrent())
+        err() << "Failed to deactivate the leased context" << std::endl;
+
+    {
+        Lock lock(m_mutex);
+
+        if (fence)
+            m_fences.push_back(fence);
+
+        m_available.push_back(context);
+    }
+
+    m_released.notify_one();
+}
+
+} // namespace sf
@@ -304,7 +304,7 @@ bool GlContext::setActive(bool active)
             Lock lock(mutex);
 
             // Activate the context
-            if (makeCurrent())
+            if (makeCurrent(true))
             {
                 // Set it as the new current context for this thread
                 currentContext = this;
@@ -338,6 +338,23 @@ bool GlContext::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+bool GlContext::releaseCurrent()
+{
+    // This context is not the active one on this thread, don't do anything
+    if (this != currentContext)
+        return true;
+
+    Lock lock(mutex);
+
+    if (!makeCurrent(false))
+        return false;
+
+    currentContext = NULL;
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::GlContext()
 {
@@ -164,6 +164,19 @@ public:
     ////////////////////////////////////////////////////////////
     bool setActive(bool active);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Deactivate the context without activating another one
+    ///
+    /// Unlike setActive(false), this leaves no context active on
+    /// the current thread, so that no internal context gets
+    /// created for it. Contexts handed over between threads,
+    /// such as the ones of a ContextPool, use this function.
+    ///
+    /// \return True if operation was successful, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool releaseCurrent();
+
     ////////////////////////////////////////////////////////////
     /// \brief Display what has been rendered to the context so far
     ///
@@ -194,13 +207,15 @@ protected:
     GlContext();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Activate the context as the current target
+    /// \brief Activate or deactivate the context as the current target
     ///        for rendering
     ///
+    /// \param current Whether to make the context current or no longer current
+    ///
     /// \return True on success, false if any error happened
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool makeCurrent() = 0;
+    virtual bool makeCurrent(bool current) = 0;
 
     ////////////////////////////////////////////////////////////
     /// \brief Evaluate a pixel format configuration
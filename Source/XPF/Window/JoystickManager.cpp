@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <XPF/Window/JoystickManager.hpp>
+#include <XPF/System/Lock.hpp>
 
 
 namespace sf
@@ -41,28 +42,104 @@ JoystickManager& JoystickManager::getInstance()
 
 
 ////////////////////////////////////////////////////////////
-const JoystickCaps& JoystickManager::getCapabilities(unsigned int joystick) const
+JoystickCaps JoystickManager::getCapabilities(unsigned int joystick) const
 {
-    return m_joysticks[joystick].capabilities;
+    JoystickState state;
+    JoystickCaps capabilities;
+    readSnapshot(joystick, state, capabilities);
+
+    return capabilities;
 }
 
 
 ////////////////////////////////////////////////////////////
-const JoystickState& JoystickManager::getState(unsigned int joystick) const
+JoystickState JoystickManager::getState(unsigned int joystick) const
 {
-    return m_joysticks[joystick].state;
+    JoystickState state;
+    JoystickCaps capabilities;
+    readSnapshot(joystick, state, capabilities);
+
+    return state;
 }
 
 
 ////////////////////////////////////////////////////////////
-const Joystick::Identification& JoystickManager::getIdentification(unsigned int joystick) const
+Joystick::Identification JoystickManager::getIdentification(unsigned int joystick) const
 {
+    // Identifications only change on connections, a lock is cheap enough
+    Lock lock(m_identificationMutex);
+
     return m_joysticks[joystick].identification;
 }
 
 
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
+{
+    // The background thread already keeps the states up to date
+    if (m_thread)
+        return;
+
+    updateJoysticks();
+    publish();
+}
+
+
+////////////////////////////////////////////////////////////
+JoystickManager::JoystickManager() :
+m_current(0),
+m_thread (NULL),
+m_running(false)
+{
+    m_sequences[0] = 0;
+    m_sequences[1] = 0;
+
+    JoystickImpl::initialize();
+
+    // Make the joysticks already connected visible right away
+    updateJoysticks();
+    publish();
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Joystick activity can be waited for, update the states in the background
+    m_running = true;
+    m_thread = new Thread(&JoystickManager::run, this);
+    m_thread->launch();
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+JoystickManager::~JoystickManager()
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    if (m_thread)
+    {
+        m_running = false;
+        JoystickImpl::interruptWait();
+        m_thread->wait();
+
+        delete m_thread;
+        m_thread = NULL;
+    }
+
+#endif
+
+    for (int i = 0; i < Joystick::Count; ++i)
+    {
+        if (m_joysticks[i].state.connected)
+            m_joysticks[i].joystick.close();
+    }
+
+    JoystickImpl::cleanup();
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickManager::updateJoysticks()
 {
     for (int i = 0; i < Joystick::Count; ++i)
     {
@@ -77,8 +154,10 @@ void JoystickManager::update()
             if (!item.state.connected)
             {
                 item.joystick.close();
-                item.capabilities   = JoystickCaps();
-                item.state          = JoystickState();
+                item.capabilities = JoystickCaps();
+                item.state        = JoystickState();
+
+                Lock lock(m_identificationMutex);
                 item.identification = Joystick::Identification();
             }
         }
@@ -89,8 +168,10 @@ void JoystickManager::update()
             {
                 if (item.joystick.open(i))
                 {
-                    item.capabilities   = item.joystick.getCapabilities();
-                    item.state          = item.joystick.update();
+                    item.capabilities = item.joystick.getCapabilities();
+                    item.state        = item.joystick.update();
+
+                    Lock lock(m_identificationMutex);
                     item.identification = item.joystick.getIdentification();
                 }
             }
@@ -100,22 +181,72 @@ void JoystickManager::update()
 
 
 ////////////////////////////////////////////////////////////
-JoystickManager::JoystickManager()
+void JoystickManager::publish()
 {
-    JoystickImpl::initialize();
+    // Write the snapshot that readers are not looking at
+    unsigned int next = 1 - m_current.load(std::memory_order_relaxed);
+
+    // Make the sequence odd while the snapshot is being written, so
+    // that a reader still copying it knows it has to start over
+    unsigned int sequence = m_sequences[next].load(std::memory_order_relaxed);
+    m_sequences[next].store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Snapshot& snapshot = m_snapshots[next];
+    for (int i = 0; i < Joystick::Count; ++i)
+    {
+        snapshot.states[i]       = m_joysticks[i].state;
+        snapshot.capabilities[i] = m_joysticks[i].capabilities;
+    }
+
+    m_sequences[next].store(sequence + 2, std::memory_order_release);
+    m_current.store(next, std::memory_order_release);
 }
 
 
 ////////////////////////////////////////////////////////////
-JoystickManager::~JoystickManager()
+void JoystickManager::readSnapshot(unsigned int joystick, JoystickState& state, JoystickCaps& capabilities) const
 {
-    for (int i = 0; i < Joystick::Count; ++i)
+    for (;;)
     {
-        if (m_joysticks[i].state.connected)
-            m_joysticks[i].joystick.close();
+        unsigned int index = m_current.load(std::memory_order_acquire);
+        unsigned int sequence = m_sequences[index].load(std::memory_order_acquire);
+
+        // The writer is already overwriting this snapshot, take the new one
+        if (sequence & 1)
+            continue;
+
+        state        = m_snapshots[index].states[joystick];
+        capabilities = m_snapshots[index].capabilities[joystick];
+
+        // Keep the copy only if the snapshot was not modified meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequences[index].load(std::memory_order_relaxed) == sequence)
+            return;
     }
+}
 
-    JoystickImpl::cleanup();
+
+////////////////////////////////////////////////////////////
+void JoystickManager::run()
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    while (m_running)
+    {
+        JoystickImpl::waitForActivity();
+
+        if (!m_running)
+            break;
+
+        updateJoysticks();
+        publish();
+
+        // Wake up the windows waiting for events
+        JoystickImpl::notifyUpdate();
+    }
+
+#endif
 }
 
 } // namespace priv
@@ -31,6 +31,9 @@
 #include <XPF/Window/Joystick.hpp>
 #include <XPF/Window/JoystickImpl.hpp>
 #include <XPF/System/NonCopyable.hpp>
+#include <XPF/System/Mutex.hpp>
+#include <XPF/System/Thread.hpp>
+#include <atomic>
 
 
 namespace sf
@@ -40,6 +43,12 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Global joystick manager
 ///
+/// States and capabilities are published in a double buffer
+/// guarded by sequence counters, so that reading them never
+/// blocks. Where the implementation can wait for joystick
+/// activity (Linux), a background thread updates them as soon
+/// as input arrives and update() does nothing.
+///
 ////////////////////////////////////////////////////////////
 class JoystickManager : NonCopyable
 {
@@ -61,7 +70,7 @@ public:
     /// \return Capabilities of the joystick
     ///
     ////////////////////////////////////////////////////////////
-    const JoystickCaps& getCapabilities(unsigned int joystick) const;
+    JoystickCaps getCapabilities(unsigned int joystick) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the current state of an open joystick
@@ -71,7 +80,7 @@ public:
     /// \return Current state of the joystick
     ///
     ////////////////////////////////////////////////////////////
-    const JoystickState& getState(unsigned int joystick) const;
+    JoystickState getState(unsigned int joystick) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the identification for an open joystick
@@ -81,7 +90,7 @@ public:
     /// \return Identification for the joystick
     ///
     ////////////////////////////////////////////////////////////
-    const Joystick::Identification& getIdentification(unsigned int joystick) const;
+    Joystick::Identification getIdentification(unsigned int joystick) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the state of all the joysticks
@@ -103,6 +112,34 @@ private:
     ////////////////////////////////////////////////////////////
     ~JoystickManager();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Poll the joysticks and handle connections
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateJoysticks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the current states visible to the readers
+    ///
+    ////////////////////////////////////////////////////////////
+    void publish();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the published state of a joystick
+    ///
+    /// \param joystick     Index of the joystick
+    /// \param state        Receives the state of the joystick
+    /// \param capabilities Receives the capabilities of the joystick
+    ///
+    ////////////////////////////////////////////////////////////
+    void readSnapshot(unsigned int joystick, JoystickState& state, JoystickCaps& capabilities) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the background update thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
     ////////////////////////////////////////////////////////////
     /// \brief Joystick information and state
     ///
@@ -115,10 +152,26 @@ private:
         Joystick::Identification identification; ///< The joystick identification
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Published copy of the states of all joysticks
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Snapshot
+    {
+        JoystickState states[Joystick::Count];       ///< States of the joysticks
+        JoystickCaps  capabilities[Joystick::Count]; ///< Capabilities of the joysticks
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Item m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    Item                      m_joysticks[Joystick::Count]; ///< Joysticks information and state, owned by the updating thread
+    Snapshot                  m_snapshots[2];               ///< Double buffer of published states
+    std::atomic<unsigned int> m_sequences[2];               ///< Sequence counter of each snapshot, odd while it is written
+    std::atomic<unsigned int> m_current;                    ///< Index of the most recently published snapshot
+    mutable Mutex             m_identificationMutex;        ///< Mutex protecting the identifications
+    Thread*                   m_thread;                     ///< Background update thread, if any
+    std::atomic<bool>         m_running;                    ///< Is the background thread supposed to keep running?
 };
 
 } // namespace priv
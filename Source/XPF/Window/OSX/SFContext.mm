@@ -124,8 +124,14 @@ GlFunctionPointer SFContext::getFunction(const char* name)
 
 
 ////////////////////////////////////////////////////////////
-bool SFContext::makeCurrent()
+bool SFContext::makeCurrent(bool current)
 {
+    if (!current)
+    {
+        [NSOpenGLContext clearCurrentContext];
+        return true;
+    }
+
     [m_context makeCurrentContext];
     return m_context == [NSOpenGLContext currentContext]; // Should be true.
 }
@@ -211,7 +211,7 @@ GlFunctionPointer GlxContext::getFunction(const char* name)
 
 
 ////////////////////////////////////////////////////////////
-bool GlxContext::makeCurrent()
+bool GlxContext::makeCurrent(bool current)
 {
     if (!m_context)
         return false;
@@ -222,7 +222,11 @@ bool GlxContext::makeCurrent()
 
     bool result = false;
 
-    if (m_pbuffer)
+    if (!current)
+    {
+        result = glXMakeCurrent(m_display, None, NULL);
+    }
+    else if (m_pbuffer)
     {
         result = glXMakeContextCurrent(m_display, m_pbuffer, m_pbuffer, m_context);
     }
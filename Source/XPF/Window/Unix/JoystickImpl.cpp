@@ -29,6 +29,8 @@
 #include <SFML/System/Err.hpp>
 #include <linux/joystick.h>
 #include <libudev.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -51,6 +53,11 @@ namespace
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    // Descriptors used to wait for joystick activity and to signal it
+    int epollFile  = -1;
+    int wakeFile   = -1;
+    int updateFile = -1;
+
     bool isJoystick(udev_device* udevDevice)
     {
         // If anything goes wrong, we go safe and return true
@@ -262,6 +269,37 @@ namespace
                FD_ISSET(monitorFd, &descriptorSet);
     }
 
+    void watchFile(int file)
+    {
+        if (epollFile < 0)
+            return;
+
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = file;
+
+        if (epoll_ctl(epollFile, EPOLL_CTL_ADD, file, &event) < 0)
+            sf::err() << "Failed to watch joystick descriptor: " << errno << std::endl;
+    }
+
+    void signalFile(int file)
+    {
+        if (file < 0)
+            return;
+
+        uint64_t value = 1;
+        ssize_t result = write(file, &value, sizeof(value));
+        (void)result; // The counter can only fail to increase when it is already signaled
+    }
+
+    void resetFile(int file)
+    {
+        uint64_t value;
+        ssize_t result = read(file, &value, sizeof(value));
+        (void)result; // EAGAIN means it was not signaled
+    }
+
     // Get a property value from a udev device
     const char* getUdevAttribute(udev_device* udevDevice, const std::string& attributeName)
     {
@@ -481,6 +519,27 @@ void JoystickImpl::initialize()
         }
     }
 
+    // Create the descriptors used to wait for activity
+    epollFile  = epoll_create1(EPOLL_CLOEXEC);
+    wakeFile   = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    updateFile = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if ((epollFile < 0) || (wakeFile < 0))
+    {
+        err() << "Failed to create joystick event queue, joysticks will be polled: " << errno << std::endl;
+
+        if (epollFile >= 0)
+            ::close(epollFile);
+        epollFile = -1;
+    }
+    else
+    {
+        watchFile(wakeFile);
+
+        if (udevMonitor)
+            watchFile(udev_monitor_get_fd(udevMonitor));
+    }
+
     // Do an initial scan
     updatePluggedList();
 }
@@ -489,6 +548,17 @@ void JoystickImpl::initialize()
 ////////////////////////////////////////////////////////////
 void JoystickImpl::cleanup()
 {
+    // Close the event descriptors
+    if (epollFile >= 0)
+        ::close(epollFile);
+    if (wakeFile >= 0)
+        ::close(wakeFile);
+    if (updateFile >= 0)
+        ::close(updateFile);
+    epollFile  = -1;
+    wakeFile   = -1;
+    updateFile = -1;
+
     // Unreference the udev monitor to destroy it
     if (udevMonitor)
     {
@@ -534,6 +604,65 @@ bool JoystickImpl::isConnected(unsigned int index)
     return joystickList[index].plugged;
 }
 
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::waitForActivity()
+{
+    if (epollFile < 0)
+    {
+        // No event queue, poll regularly
+        usleep(10000);
+        return;
+    }
+
+    // Without a monitor, connections are only found by scanning
+    int timeout = udevMonitor ? -1 : 1000;
+
+    epoll_event events[Joystick::Count + 2];
+    int count = epoll_wait(epollFile, events, Joystick::Count + 2, timeout);
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (events[i].data.fd == wakeFile)
+        {
+            resetFile(wakeFile);
+        }
+        else if (udevMonitor && (events[i].data.fd == udev_monitor_get_fd(udevMonitor)))
+        {
+            // Consume the notification here: if every slot is
+            // connected, nobody would call isConnected to read it
+            udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+
+            updatePluggedList(udevDevice);
+
+            if (udevDevice)
+                udev_device_unref(udevDevice);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::interruptWait()
+{
+    signalFile(wakeFile);
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::notifyUpdate()
+{
+    signalFile(updateFile);
+}
+
+
+////////////////////////////////////////////////////////////
+int JoystickImpl::getUpdateDescriptor()
+{
+    return updateFile;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
@@ -563,6 +692,8 @@ bool JoystickImpl::open(unsigned int index)
             // Reset the joystick state
             m_state = JoystickState();
 
+            watchFile(m_file);
+
             return true;
         }
         else
@@ -578,6 +709,9 @@ bool JoystickImpl::open(unsigned int index)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::close()
 {
+    if (epollFile >= 0)
+        epoll_ctl(epollFile, EPOLL_CTL_DEL, m_file, NULL);
+
     ::close(m_file);
     m_file = -1;
 }
@@ -66,6 +66,40 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until there is joystick activity
+    ///
+    /// Returns when an opened joystick has pending input, when
+    /// a device is plugged or unplugged, or when interruptWait()
+    /// is called. Without a udev monitor, connections can only be
+    /// detected by scanning so the function also returns every second.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void waitForActivity();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a pending or the next call to waitForActivity return
+    ///
+    ////////////////////////////////////////////////////////////
+    static void interruptWait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Signal that new joystick states were published
+    ///
+    ////////////////////////////////////////////////////////////
+    static void notifyUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptor signaled by notifyUpdate
+    ///
+    /// The descriptor becomes readable after notifyUpdate() was
+    /// called; read a 64-bit counter from it to reset it.
+    ///
+    /// \return File descriptor, or -1 if not available
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getUpdateDescriptor();
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -37,11 +37,14 @@
 #include <xcb/xcb_image.h>
 #include <xcb/randr.h>
 #include <X11/Xlibint.h>
+#include <X11/XKBlib.h>
+#include <X11/extensions/XInput2.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -64,6 +67,8 @@ namespace
     std::vector<sf::priv::WindowImplX11*> allWindows;
     sf::Mutex                             allWindowsMutex;
     sf::String                            windowManagerName;
+    int                                   xinputOpcode = -1;
+    unsigned int                          rawInputWindowCount = 0;
 
     static const unsigned long            eventMask = XCB_EVENT_MASK_FOCUS_CHANGE   | XCB_EVENT_MASK_BUTTON_PRESS     |
                                                       XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_BUTTON_MOTION    |
@@ -71,11 +76,54 @@ namespace
                                                       XCB_EVENT_MASK_KEY_RELEASE    | XCB_EVENT_MASK_STRUCTURE_NOTIFY |
                                                       XCB_EVENT_MASK_ENTER_WINDOW   | XCB_EVENT_MASK_LEAVE_WINDOW;
 
+    // Events accepted by a window
+    struct EventFilter
+    {
+        ::Window window;
+        bool     rawEvents;
+    };
+
     // Filter the events received by windows (only allow those matching a specific window)
     Bool checkEvent(::Display*, XEvent* event, XPointer userData)
     {
+        const EventFilter* filter = reinterpret_cast<const EventFilter*>(userData);
+
+        // XInput raw events are reported to the root window, any window recording them can take them
+        if (event->type == GenericEvent)
+            return filter->rawEvents && (event->xcookie.extension == xinputOpcode);
+
         // Just check if the event matches the window
-        return event->xany.window == reinterpret_cast< ::Window >(userData);
+        return event->xany.window == filter->window;
+    }
+
+    // Filter the XInput raw events
+    Bool checkRawEvent(::Display*, XEvent* event, XPointer)
+    {
+        return (event->type == GenericEvent) && (event->xcookie.extension == xinputOpcode);
+    }
+
+    // Select the XInput raw events on the root window, or stop receiving them
+    void selectRawEvents(::Display* display, bool enabled)
+    {
+        unsigned char mask[XIMaskLen(XI_LASTEVENT)];
+        std::memset(mask, 0, sizeof(mask));
+
+        if (enabled)
+        {
+            XISetMask(mask, XI_RawKeyPress);
+            XISetMask(mask, XI_RawKeyRelease);
+            XISetMask(mask, XI_RawButtonPress);
+            XISetMask(mask, XI_RawButtonRelease);
+            XISetMask(mask, XI_RawMotion);
+        }
+
+        XIEventMask rawEventMask;
+        rawEventMask.deviceid = XIAllMasterDevices;
+        rawEventMask.mask_len = sizeof(mask);
+        rawEventMask.mask     = mask;
+
+        XISelectEvents(display, DefaultRootWindow(display), &rawEventMask, 1);
+        XFlush(display);
     }
 
     // Find the name of the current executable
@@ -570,6 +618,10 @@ WindowImplX11::~WindowImplX11()
     if (m_inputMethod)
         XCloseIM(m_inputMethod);
 
+    // Stop receiving raw events
+    if (isRawInputEnabled())
+        enableRawInput(false);
+
     // Close the connection with the X server
     CloseDisplay(m_display);
 
@@ -589,11 +641,120 @@ WindowHandle WindowImplX11::getSystemHandle() const
 ////////////////////////////////////////////////////////////
 void WindowImplX11::processEvents()
 {
+    EventFilter filter = {m_window, isRawInputEnabled()};
+
     XEvent event;
-    while (XCheckIfEvent(m_display, &event, &checkEvent, reinterpret_cast<XPointer>(m_window)))
+    while (XCheckIfEvent(m_display, &event, &checkEvent, reinterpret_cast<XPointer>(&filter)))
+    {
+        if (event.type == GenericEvent)
+            processRawEvent(event);
+        else
+            processEvent(event);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplX11::waitForEvents(Time timeout)
+{
+    // Flush our requests and read what the server already sent; events
+    // queued for other windows sharing the display would make poll()
+    // useless, fall back to polling until they are processed
+    if (XEventsQueued(m_display, QueuedAfterFlush) > 0)
+    {
+        WindowImpl::waitForEvents(timeout);
+        return;
+    }
+
+    int milliseconds = -1;
+    if (timeout >= Time::Zero)
+        milliseconds = static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+
+    std::vector<pollfd> descriptors(1);
+    descriptors[0].fd = ConnectionNumber(m_display);
+    descriptors[0].events = POLLIN;
+    descriptors[0].revents = 0;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Wake up when the joystick thread published new states
+    int updateDescriptor = JoystickImpl::getUpdateDescriptor();
+    if (updateDescriptor >= 0)
+    {
+        pollfd descriptor;
+        descriptor.fd = updateDescriptor;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        descriptors.push_back(descriptor);
+    }
+    else if ((milliseconds < 0) || (milliseconds > 10))
+    {
+        milliseconds = 10;
+    }
+
+#else
+
+    // Joysticks must be polled on this platform
+    if ((milliseconds < 0) || (milliseconds > 10))
+        milliseconds = 10;
+
+#endif
+
+    // Interruptions and errors just make the caller process events and wait again
+    poll(&descriptors[0], descriptors.size(), milliseconds);
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Reset the notification, the caller processes the new states
+    if ((descriptors.size() > 1) && (descriptors[1].revents & POLLIN))
+    {
+        uint64_t value;
+        ssize_t result = read(descriptors[1].fd, &value, sizeof(value));
+        (void)result;
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImplX11::enableRawInput(bool enabled)
+{
+    Lock lock(allWindowsMutex);
+
+    if (enabled)
+    {
+        // Raw events require XInput 2
+        if (xinputOpcode < 0)
+        {
+            int opcode, firstEvent, firstError;
+            int major = 2;
+            int minor = 0;
+            if (!XQueryExtension(m_display, "XInputExtension", &opcode, &firstEvent, &firstError) ||
+                (XIQueryVersion(m_display, &major, &minor) != Success))
+            {
+                err() << "XInput 2 is not available, raw input is not supported" << std::endl;
+                return false;
+            }
+
+            xinputOpcode = opcode;
+        }
+
+        // The selection on the root window is shared by all the windows of the display
+        if (rawInputWindowCount++ == 0)
+            selectRawEvents(m_display, true);
+    }
+    else if (--rawInputWindowCount == 0)
     {
-        processEvent(event);
+        selectRawEvents(m_display, false);
+
+        // Discard the raw events still queued, nobody will take them anymore
+        XEvent event;
+        while (XCheckIfEvent(m_display, &event, &checkRawEvent, NULL))
+            continue;
     }
+
+    return true;
 }
 
 
@@ -1979,6 +2140,98 @@ bool WindowImplX11::processEvent(XEvent windowEvent)
     return true;
 }
 
+
+////////////////////////////////////////////////////////////
+void WindowImplX11::processRawEvent(XEvent& windowEvent)
+{
+    XGenericEventCookie& cookie = windowEvent.xcookie;
+    if (!XGetEventData(m_display, &cookie))
+        return;
+
+    // Raw events carry the X server time at which they happened, in milliseconds
+    const XIRawEvent* rawEvent = static_cast<const XIRawEvent*>(cookie.data);
+
+    switch (cookie.evtype)
+    {
+        // Key pressed or released
+        case XI_RawKeyPress:
+        case XI_RawKeyRelease:
+        {
+            // Translate the keycode without modifiers, like the physical key
+            KeySym symbol = XkbKeycodeToKeysym(m_display, static_cast<KeyCode>(rawEvent->detail), 0, 0);
+
+            RawEvent event;
+            event.type     = (cookie.evtype == XI_RawKeyPress) ? RawEvent::KeyPressed : RawEvent::KeyReleased;
+            event.key.code = keysymToSF(symbol);
+            pushRawEvent(event, static_cast<Uint32>(rawEvent->time));
+            break;
+        }
+
+        // Mouse button pressed or released
+        case XI_RawButtonPress:
+        case XI_RawButtonRelease:
+        {
+            bool pressed = (cookie.evtype == XI_RawButtonPress);
+            int button = rawEvent->detail;
+
+            RawEvent event;
+            if ((button == Button1) ||
+                (button == Button2) ||
+                (button == Button3) ||
+                (button == 8) ||
+                (button == 9))
+            {
+                event.type = pressed ? RawEvent::MouseButtonPressed : RawEvent::MouseButtonReleased;
+                switch(button)
+                {
+                    case Button1: event.mouseButton.button = Mouse::Left;     break;
+                    case Button2: event.mouseButton.button = Mouse::Middle;   break;
+                    case Button3: event.mouseButton.button = Mouse::Right;    break;
+                    case 8:       event.mouseButton.button = Mouse::XButton1; break;
+                    case 9:       event.mouseButton.button = Mouse::XButton2; break;
+                }
+                pushRawEvent(event, static_cast<Uint32>(rawEvent->time));
+            }
+            else if (pressed && (button >= Button4) && (button <= 7))
+            {
+                // Buttons 4 and 5 are the vertical wheel, 6 and 7 the horizontal one
+                event.type                   = RawEvent::MouseWheelScrolled;
+                event.mouseWheelScroll.wheel = (button <= Button5) ? Mouse::VerticalWheel : Mouse::HorizontalWheel;
+                event.mouseWheelScroll.delta = ((button == Button4) || (button == 6)) ? 1.f : -1.f;
+                pushRawEvent(event, static_cast<Uint32>(rawEvent->time));
+            }
+            break;
+        }
+
+        // Mouse moved
+        case XI_RawMotion:
+        {
+            // The values of the valuators present in the mask are packed
+            // in order; the first two are the X and Y axes
+            double delta[2] = {0, 0};
+            const double* value = rawEvent->raw_values;
+            for (int i = 0; (i < 2) && (i < rawEvent->valuators.mask_len * 8); ++i)
+            {
+                if (XIMaskIsSet(rawEvent->valuators.mask, i))
+                    delta[i] = *value++;
+            }
+
+            // Motion of the other valuators only (smooth scrolling, pressure...)
+            if ((delta[0] == 0) && (delta[1] == 0))
+                break;
+
+            RawEvent event;
+            event.type             = RawEvent::MouseMoved;
+            event.mouseMove.deltaX = static_cast<float>(delta[0]);
+            event.mouseMove.deltaY = static_cast<float>(delta[1]);
+            pushRawEvent(event, static_cast<Uint32>(rawEvent->time));
+            break;
+        }
+    }
+
+    XFreeEventData(m_display, &cookie);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -178,6 +178,24 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the X server or a joystick has new events
+    ///
+    /// \param timeout Maximum time to wait, negative to wait forever
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop receiving XInput 2 raw events
+    ///
+    /// \param enabled True to start, false to stop
+    ///
+    /// \return True if the operation succeeded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool enableRawInput(bool enabled);
+
 private:
 
     struct WMHints
@@ -303,6 +321,14 @@ private:
     ////////////////////////////////////////////////////////////
     bool processEvent(XEvent windowEvent);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process an incoming XInput 2 raw event
+    ///
+    /// \param windowEvent Generic event which has been received
+    ///
+    ////////////////////////////////////////////////////////////
+    void processRawEvent(XEvent& windowEvent);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -91,12 +91,14 @@ public:
     static GlFunctionPointer getFunction(const char* name);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Activate the context as the current target for rendering
+    /// \brief Activate or deactivate the context as the current target for rendering
+    ///
+    /// \param current Whether to make the context current or no longer current
     ///
     /// \return True on success, false if any error happened
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool makeCurrent();
+    virtual bool makeCurrent(bool current);
 
     ////////////////////////////////////////////////////////////
     /// \brief Display what has been rendered to the context so far
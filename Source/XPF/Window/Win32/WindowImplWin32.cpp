@@ -263,6 +263,26 @@ void WindowImplWin32::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::waitForEvents(Time timeout)
+{
+    // Messages of windows we don't own are not ours to wait for
+    if (m_callback)
+    {
+        WindowImpl::waitForEvents(timeout);
+        return;
+    }
+
+    // Joysticks must still be polled, so never wait more than 10 ms; but
+    // unlike a plain sleep, window messages wake us up immediately
+    DWORD milliseconds = 10;
+    if ((timeout >= Time::Zero) && (timeout < sf::milliseconds(10)))
+        milliseconds = static_cast<DWORD>((timeout.asMicroseconds() + 999) / 1000);
+
+    MsgWaitForMultipleObjects(0, NULL, FALSE, milliseconds, QS_ALLINPUT);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplWin32::getPosition() const
 {
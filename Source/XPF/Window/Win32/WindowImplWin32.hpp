@@ -176,6 +176,14 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the thread receives new messages
+    ///
+    /// \param timeout Maximum time to wait, negative to wait forever
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -28,8 +28,8 @@
 #include <XPF/Window/Window.hpp>
 #include <XPF/Window/GlContext.hpp>
 #include <XPF/Window/WindowImpl.hpp>
-#include <XPF/System/Sleep.hpp>
 #include <XPF/System/Err.hpp>
+#include <algorithm>
 
 
 namespace
@@ -44,7 +44,7 @@ namespace sf
 Window::Window() :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
+m_framePacer    (),
 m_size          (0, 0)
 {
 
@@ -55,7 +55,7 @@ m_size          (0, 0)
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
+m_framePacer    (),
 m_size          (0, 0)
 {
     create(mode, title, style, settings);
@@ -66,7 +66,7 @@ m_size          (0, 0)
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
+m_framePacer    (),
 m_size          (0, 0)
 {
     create(handle, settings);
@@ -209,6 +209,49 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::waitEvent(Event& event, Time timeout)
+{
+    // Negative timeouts mean "wait forever" internally, don't let them through
+    if (m_impl && m_impl->popEvent(event, std::max(timeout, Time::Zero)))
+    {
+        return filterEvent(event);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Window::setRawInputEnabled(bool enabled, std::size_t capacity)
+{
+    return m_impl && m_impl->setRawInputEnabled(enabled, capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Window::pollRawEvents(RawEvent* events, std::size_t maxCount)
+{
+    return m_impl ? m_impl->popRawEvents(events, maxCount) : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Window::getDroppedRawEventCount() const
+{
+    return m_impl ? m_impl->getDroppedRawEventCount() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Window::getRawInputTime() const
+{
+    return m_impl ? m_impl->getRawInputTime() : Time::Zero;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -300,9 +343,16 @@ void Window::setKeyRepeatEnabled(bool enabled)
 void Window::setFramerateLimit(unsigned int limit)
 {
     if (limit > 0)
-        m_frameTimeLimit = seconds(1.f / limit);
+        m_framePacer.setFrameTime(seconds(1.f / limit));
     else
-        m_frameTimeLimit = Time::Zero;
+        m_framePacer.setFrameTime(Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer& Window::getFramePacer()
+{
+    return m_framePacer;
 }
 
 
@@ -355,16 +405,16 @@ bool Window::hasFocus() const
 
 void Window::display()
 {
+    // Let the derived class finish its pending rendering
+    onDisplay();
+
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
 
     // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+    if (m_framePacer.getFrameTime() != Time::Zero)
+        m_framePacer.wait();
 }
 
 
@@ -389,6 +439,13 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {
@@ -421,7 +478,7 @@ void Window::initialize()
     m_size = m_impl->getSize();
 
     // Reset frame time
-    m_clock.restart();
+    m_framePacer.restart();
 
     // Activate the window
     setActive();
@@ -29,6 +29,8 @@
 #include <XPF/Window/Event.hpp>
 #include <XPF/Window/JoystickManager.hpp>
 #include <XPF/Window/SensorManager.hpp>
+#include <XPF/System/Clock.hpp>
+#include <XPF/System/Err.hpp>
 #include <XPF/System/Sleep.hpp>
 #include <algorithm>
 #include <cmath>
@@ -81,7 +83,13 @@ WindowImpl* WindowImpl::create(WindowHandle handle)
 
 ////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl() :
-m_joystickThreshold(0.1f)
+m_joystickThreshold(0.1f),
+m_rawEventsFirst   (0),
+m_rawEventsCount   (0),
+m_rawEventsDropped (0),
+m_systemTimeSynced (false),
+m_systemTimeBase   (0),
+m_systemTimeOffset (0)
 {
     // Get the initial joystick states
     JoystickManager::getInstance().update();
@@ -110,6 +118,14 @@ void WindowImpl::setJoystickThreshold(float threshold)
 
 ////////////////////////////////////////////////////////////
 bool WindowImpl::popEvent(Event& event, bool block)
+{
+    // A negative timeout waits forever
+    return popEvent(event, block ? microseconds(-1) : Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::popEvent(Event& event, Time timeout)
 {
     // If the event queue is empty, let's first check if new events are available from the OS
     if (m_events.empty())
@@ -120,14 +136,22 @@ bool WindowImpl::popEvent(Event& event, bool block)
         processEvents();
 
         // In blocking mode, we must process events until one is triggered
-        if (block)
+        if (timeout != Time::Zero)
         {
-            // Here we use a manual wait loop instead of the optimized
-            // wait-event provided by the OS, so that we don't skip joystick
-            // events (which require polling)
+            Clock clock;
             while (m_events.empty())
             {
-                sleep(milliseconds(10));
+                Time remaining = timeout;
+                if (timeout > Time::Zero)
+                {
+                    remaining = timeout - clock.getElapsedTime();
+                    if (remaining <= Time::Zero)
+                        break;
+                }
+
+                // Let the implementation sleep until the system has something
+                // for us; it may wake up early, hence the loop
+                waitForEvents(remaining);
                 processJoystickEvents();
                 processSensorEvents();
                 processEvents();
@@ -148,6 +172,76 @@ bool WindowImpl::popEvent(Event& event, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+bool WindowImpl::setRawInputEnabled(bool enabled, std::size_t capacity)
+{
+    if (enabled && (capacity == 0))
+    {
+        err() << "Failed to enable raw input: the buffer capacity must not be zero" << std::endl;
+        return false;
+    }
+
+    // Start or stop receiving raw input, unless we already do
+    if (enabled != isRawInputEnabled())
+    {
+        if (!enableRawInput(enabled))
+        {
+            if (enabled)
+                err() << "Raw input is not supported by this window" << std::endl;
+            return false;
+        }
+
+        m_rawInputClock.restart();
+        m_rawEventsDropped = 0;
+        m_systemTimeSynced = false;
+    }
+
+    // Events left in the buffer are discarded
+    std::vector<RawEvent>(enabled ? capacity : 0).swap(m_rawEvents);
+    m_rawEventsFirst = 0;
+    m_rawEventsCount = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t WindowImpl::popRawEvents(RawEvent* events, std::size_t maxCount)
+{
+    if (!isRawInputEnabled())
+        return 0;
+
+    // Get the raw events from the system
+    processEvents();
+
+    // Copy the events in at most two contiguous blocks
+    std::size_t count = std::min(maxCount, m_rawEventsCount);
+    std::size_t firstBlock = std::min(count, m_rawEvents.size() - m_rawEventsFirst);
+
+    std::copy(m_rawEvents.begin() + m_rawEventsFirst, m_rawEvents.begin() + m_rawEventsFirst + firstBlock, events);
+    std::copy(m_rawEvents.begin(), m_rawEvents.begin() + (count - firstBlock), events + firstBlock);
+
+    m_rawEventsFirst = (m_rawEventsFirst + count) % m_rawEvents.size();
+    m_rawEventsCount -= count;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 WindowImpl::getDroppedRawEventCount() const
+{
+    return m_rawEventsDropped;
+}
+
+
+////////////////////////////////////////////////////////////
+Time WindowImpl::getRawInputTime() const
+{
+    return m_rawInputClock.getElapsedTime();
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImpl::pushEvent(const Event& event)
 {
@@ -155,6 +249,109 @@ void WindowImpl::pushEvent(const Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::pushRawEvent(const RawEvent& event)
+{
+    if (!isRawInputEnabled())
+        return;
+
+    std::size_t capacity = m_rawEvents.size();
+
+    // Overwrite the oldest event if the buffer is full
+    if (m_rawEventsCount == capacity)
+    {
+        m_rawEventsFirst = (m_rawEventsFirst + 1) % capacity;
+        --m_rawEventsCount;
+        ++m_rawEventsDropped;
+    }
+
+    RawEvent& slot = m_rawEvents[(m_rawEventsFirst + m_rawEventsCount) % capacity];
+    slot = event;
+    slot.timestamp = m_rawInputClock.getElapsedTime();
+
+    ++m_rawEventsCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::pushRawEvent(const RawEvent& event, Uint32 systemTime)
+{
+    if (!isRawInputEnabled())
+        return;
+
+    pushRawEvent(event);
+
+    // The slot just written is the newest one
+    std::size_t newest = (m_rawEventsFirst + m_rawEventsCount - 1) % m_rawEvents.size();
+    m_rawEvents[newest].timestamp = mapSystemTime(systemTime);
+}
+
+
+////////////////////////////////////////////////////////////
+Time WindowImpl::mapSystemTime(Uint32 systemTime)
+{
+    Int64 now = m_rawInputClock.getElapsedTime().asMicroseconds();
+
+    // The first event gives a first estimate of the offset between the two clocks
+    if (!m_systemTimeSynced)
+    {
+        m_systemTimeBase   = systemTime;
+        m_systemTimeOffset = now;
+        m_systemTimeSynced = true;
+    }
+
+    // Work with the difference to the previous event, so that the
+    // wrapping of the system's counter (every 49 days) doesn't matter
+    Int32 elapsed = static_cast<Int32>(systemTime - m_systemTimeBase);
+    Int64 time = m_systemTimeOffset + static_cast<Int64>(elapsed) * 1000;
+
+    // An event can't have happened after it was received: that means
+    // the previous ones waited longer before being processed, so the
+    // offset is corrected to the smallest delay seen so far
+    if (time > now)
+    {
+        m_systemTimeOffset -= time - now;
+        time = now;
+    }
+
+    if (elapsed > 0)
+    {
+        m_systemTimeBase   = systemTime;
+        m_systemTimeOffset = time;
+    }
+
+    return microseconds(time);
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::isRawInputEnabled() const
+{
+    return !m_rawEvents.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::enableRawInput(bool enabled)
+{
+    // Not supported by default, disabling always succeeds
+    return !enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::waitForEvents(Time timeout)
+{
+    // Without a way to wait for the system, poll it regularly so that
+    // we don't skip joystick and sensor events (which require polling)
+    Time period = milliseconds(10);
+    if ((timeout >= Time::Zero) && (timeout < period))
+        period = timeout;
+
+    sleep(period);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImpl::processJoystickEvents()
 {
@@ -30,8 +30,11 @@
 ////////////////////////////////////////////////////////////
 #include <XPF/Config.hpp>
 #include <XPF/System/NonCopyable.hpp>
+#include <XPF/System/Clock.hpp>
 #include <XPF/System/String.hpp>
+#include <XPF/System/Time.hpp>
 #include <XPF/Window/Event.hpp>
+#include <XPF/Window/RawEvent.hpp>
 #include <XPF/Window/Joystick.hpp>
 #include <XPF/Window/JoystickImpl.hpp>
 #include <XPF/Window/Sensor.hpp>
@@ -41,6 +44,7 @@
 #include <XPF/Window/ContextSettings.hpp>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace sf
 {
@@ -112,6 +116,60 @@ public:
     ////////////////////////////////////////////////////////////
     bool popEvent(Event& event, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next window event available, waiting at most a given time
+    ///
+    /// This function behaves like the blocking version of popEvent,
+    /// except that it gives up when \a timeout has elapsed.
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event, negative to wait forever
+    ///
+    /// \return True if an event was returned, false if the timeout elapsed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popEvent(Event& event, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the recording of raw input events
+    ///
+    /// \param enabled  True to enable, false to disable
+    /// \param capacity Maximum number of raw events kept until they are popped
+    ///
+    /// \return True if the operation succeeded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setRawInputEnabled(bool enabled, std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the oldest raw input events recorded
+    ///
+    /// This function processes the pending system events first.
+    ///
+    /// \param events   Array receiving the events
+    /// \param maxCount Maximum number of events to return
+    ///
+    /// \return Number of events written to \a events
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t popRawEvents(RawEvent* events, std::size_t maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of raw events lost because the buffer was full
+    ///
+    /// \return Number of raw events dropped since raw input was enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedRawEventCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the clock used to stamp raw events
+    ///
+    /// \return Time elapsed since raw input was enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRawInputTime() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -229,12 +287,73 @@ protected:
     ////////////////////////////////////////////////////////////
     void pushEvent(const Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a new event into the raw event buffer
+    ///
+    /// The event is stamped with the current time, for systems
+    /// that don't report when input events happen. If the buffer
+    /// is full, the oldest event is dropped. Nothing happens if
+    /// raw input is disabled.
+    ///
+    /// \param event Event to push
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushRawEvent(const RawEvent& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a new event stamped by the system into the raw event buffer
+    ///
+    /// \a systemTime is the time at which the event happened, as
+    /// a wrapping 32-bit count of milliseconds (X server time,
+    /// Windows message time); it is mapped onto the clock of
+    /// getRawInputTime, so that events are stamped when they
+    /// happened rather than when they were processed.
+    ///
+    /// \param event      Event to push
+    /// \param systemTime Time of the event, in milliseconds, on the system's clock
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushRawEvent(const RawEvent& event, Uint32 systemTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether raw input events are being recorded
+    ///
+    /// \return True if raw input is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRawInputEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Process incoming events from the operating system
     ///
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the operating system has new events to process
+    ///
+    /// The default implementation sleeps for a short time, so that
+    /// joysticks and sensors keep being polled. Implementations may
+    /// return early: the caller processes events and waits again.
+    ///
+    /// \param timeout Maximum time to wait, negative to wait forever
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop receiving raw input from the system
+    ///
+    /// Implementations report raw events with pushRawEvent.
+    /// The default implementation doesn't support raw input.
+    ///
+    /// \param enabled True to start, false to stop
+    ///
+    /// \return True if the operation succeeded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool enableRawInput(bool enabled);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -249,13 +368,31 @@ private:
     ////////////////////////////////////////////////////////////
     void processSensorEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a system time stamp to the raw input clock
+    ///
+    /// \param systemTime Time stamp, in milliseconds, on the system's clock
+    ///
+    /// \return Corresponding time on the raw input clock
+    ///
+    ////////////////////////////////////////////////////////////
+    Time mapSystemTime(Uint32 systemTime);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::queue<Event> m_events;                          ///< Queue of available events
-    JoystickState     m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
-    Vector3f          m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
-    float             m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    std::queue<Event>     m_events;                          ///< Queue of available events
+    JoystickState         m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
+    Vector3f              m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
+    float                 m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    std::vector<RawEvent> m_rawEvents;                       ///< Ring buffer of raw events, empty when raw input is disabled
+    std::size_t           m_rawEventsFirst;                  ///< Index of the oldest raw event in the ring buffer
+    std::size_t           m_rawEventsCount;                  ///< Number of raw events in the ring buffer
+    Uint64                m_rawEventsDropped;                ///< Number of raw events dropped because the buffer was full
+    Clock                 m_rawInputClock;                   ///< Clock stamping the raw events
+    bool                  m_systemTimeSynced;                ///< Is the mapping of system time stamps initialized?
+    Uint32                m_systemTimeBase;                  ///< System time stamp of the latest mapped event
+    Int64                 m_systemTimeOffset;                ///< Time of m_systemTimeBase on the raw input clock, in microseconds
 };
 
 } // namespace priv
@@ -123,13 +123,15 @@ public:
 protected:
 
     ////////////////////////////////////////////////////////////
-    /// \brief Activate the context as the current target
+    /// \brief Activate or deactivate the context as the current target
     ///        for rendering
     ///
+    /// \param current Whether to make the context current or no longer current
+    ///
     /// \return True on success, false if any error happened
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool makeCurrent();
+    virtual bool makeCurrent(bool current);
 
 private:
 
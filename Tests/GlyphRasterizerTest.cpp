@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/GlyphRasterizer.hpp>
+#include <XPF/System/Sleep.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+
+
+namespace
+{
+    typedef sf::priv::GlyphRasterizer::Request Request;
+    typedef sf::priv::GlyphRasterizer::Result  Result;
+
+    // Sort key of a request
+    sf::Uint64 requestKey(const Request& request)
+    {
+        return (static_cast<sf::Uint64>(request.codePoint) << 32) | (request.characterSize << 1) | (request.bold ? 1 : 0);
+    }
+
+    // Rasterize a glyph the way sf::Font::loadGlyph does, on the calling thread
+    Result rasterizeSync(FT_Library library, FT_Face face, const Request& request)
+    {
+        Result result;
+        result.request = request;
+        result.valid   = false;
+        if ((face->size->metrics.x_ppem == request.characterSize) || (FT_Set_Pixel_Sizes(face, 0, request.characterSize) == 0))
+            result.valid = sf::priv::GlyphRasterizer::rasterize(library, face, request.codePoint, request.bold,
+                                                                  result.glyph, result.pixels, result.width, result.height);
+        if ((result.width == 0) || (result.height == 0))
+            result.pixels.clear();
+        return result;
+    }
+
+    // Rasterize glyphs with the background workers, and wait for all of them
+    bool rasterizeAsync(sf::priv::GlyphRasterizer& rasterizer, const std::vector<Request>& requests, std::map<sf::Uint64, Result>& results)
+    {
+        rasterizer.push(requests);
+
+        std::vector<Result> collected;
+        for (int i = 0; (i < 10000) && (results.size() < requests.size()); ++i)
+        {
+            rasterizer.collect(collected);
+            for (std::vector<Result>::iterator it = collected.begin(); it != collected.end(); ++it)
+                results[requestKey(it->request)] = *it;
+
+            if (results.size() < requests.size())
+                sf::sleep(sf::milliseconds(1));
+        }
+
+        return results.size() == requests.size();
+    }
+
+    // Compare a glyph rasterized in the background with the same glyph rasterized synchronously
+    bool compare(const Result& async, const Result& sync)
+    {
+        const Request& request = sync.request;
+        const char* difference = NULL;
+        if (async.valid != sync.valid)
+            difference = "validity";
+        else if (async.glyph.advance != sync.glyph.advance)
+            difference = "advance";
+        else if (async.glyph.bounds != sync.glyph.bounds)
+            difference = "bounds";
+        else if ((async.width != sync.width) || (async.height != sync.height))
+            difference = "bitmap size";
+        else if ((sync.width > 0) && (sync.height > 0) && !std::equal(sync.pixels.begin(), sync.pixels.end(), async.pixels.begin()))
+            difference = "pixels";
+
+        if (difference)
+        {
+            std::cerr << "Glyph " << request.codePoint << " (size " << request.characterSize << (request.bold ? ", bold" : "")
+                      << "): different " << difference << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Check that the glyphs rasterized by sf::priv::GlyphRasterizer
+/// are identical to those rasterized synchronously by sf::Font
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <font file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string filename = argv[1];
+
+    // Open the face used by the synchronous path
+    FT_Library library;
+    FT_Face face;
+    if ((FT_Init_FreeType(&library) != 0) || (FT_New_Face(library, filename.c_str(), 0, &face) != 0) ||
+        (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0))
+    {
+        std::cerr << "Failed to open " << filename << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Printable ASCII and a few accented characters, at several sizes, regular and bold
+    std::vector<Request> requests;
+    const unsigned int sizes[] = {9, 16, 30, 64};
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+    {
+        for (sf::Uint32 codePoint = 32; codePoint < 256; ++codePoint)
+        {
+            if ((codePoint >= 127) && (codePoint < 192))
+                continue;
+
+            Request request = {codePoint, sizes[s], false};
+            requests.push_back(request);
+            request.bold = true;
+            requests.push_back(request);
+        }
+    }
+
+    std::map<sf::Uint64, Result> expected;
+    for (std::vector<Request>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+        expected[requestKey(*it)] = rasterizeSync(library, face, *it);
+
+    // Workers opening the file, then workers reading it from memory
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    for (int source = 0; source < 2; ++source)
+    {
+        sf::priv::GlyphRasterizer* rasterizer = (source == 0) ? new sf::priv::GlyphRasterizer(filename)
+                                                              : new sf::priv::GlyphRasterizer(&data[0], data.size());
+
+        // Push the requests twice, the second time after the workers went idle
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            std::map<sf::Uint64, Result> results;
+            if (!rasterizeAsync(*rasterizer, requests, results))
+            {
+                std::cerr << "Only " << results.size() << " of " << requests.size() << " glyphs were rasterized" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            for (std::map<sf::Uint64, Result>::const_iterator it = results.begin(); it != results.end(); ++it)
+            {
+                if (!compare(it->second, expected[it->first]))
+                    return EXIT_FAILURE;
+            }
+        }
+
+        // Destroying the pool with pending requests must not block
+        rasterizer->push(requests);
+        delete rasterizer;
+    }
+
+    std::cout << "Compared " << requests.size() << " glyphs rasterized by the workers and synchronously" << std::endl;
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/ImageKernels.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Original sf::Image::copy loop, with applyAlpha
+    void blendReference(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            const sf::Uint8* src = source + j * 4;
+            sf::Uint8*       dst = destination + j * 4;
+
+            sf::Uint8 alpha = src[3];
+            dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
+            dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
+            dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
+            dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+        }
+    }
+
+    // Original sf::Image::createMaskFromColor loop
+    void maskReference(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        sf::Uint8* ptr = pixels;
+        sf::Uint8* end = ptr + count * 4;
+        while (ptr < end)
+        {
+            if ((ptr[0] == color[0]) && (ptr[1] == color[1]) && (ptr[2] == color[2]) && (ptr[3] == color[3]))
+                ptr[3] = alpha;
+            ptr += 4;
+        }
+    }
+
+    // Original sf::Image::flipHorizontally loop, for one row
+    void reverseReference(sf::Uint8* pixels, std::size_t count)
+    {
+        sf::Uint8* left  = pixels;
+        sf::Uint8* right = pixels + (count - 1) * 4;
+        for (std::size_t x = 0; x < count / 2; ++x)
+        {
+            std::swap_ranges(left, left + 4, right);
+            left  += 4;
+            right -= 4;
+        }
+    }
+
+    // Original sf::Image::flipVertically loop, for one pair of rows
+    void swapReference(sf::Uint8* first, sf::Uint8* second, std::size_t count)
+    {
+        std::swap_ranges(first, first + count * 4, second);
+    }
+
+    // Blend rows of an image over another one, as sf::Image::copy does
+    class BlendTask : public sf::priv::RowTask
+    {
+    public:
+
+        BlendTask(const sf::Uint8* source, sf::Uint8* destination, std::size_t width) :
+        m_source     (source),
+        m_destination(destination),
+        m_width      (width)
+        {
+        }
+
+        virtual void process(unsigned int begin, unsigned int end)
+        {
+            for (unsigned int i = begin; i < end; ++i)
+                sf::priv::blendPixels(m_source + i * m_width * 4, m_destination + i * m_width * 4, m_width);
+        }
+
+    private:
+
+        const sf::Uint8* m_source;
+        sf::Uint8*       m_destination;
+        std::size_t      m_width;
+    };
+
+    template <typename F>
+    double measure(F function, int iterations)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            function();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    }
+
+    void report(const char* name, double reference, double kernel)
+    {
+        std::cout << "  " << name << ": " << reference << " us -> " << kernel << " us (x" << reference / kernel << ")" << std::endl;
+    }
+
+    bool check(const char* name, const std::vector<sf::Uint8>& result, const std::vector<sf::Uint8>& expected)
+    {
+        if (result == expected)
+            return true;
+
+        std::size_t i = std::mismatch(result.begin(), result.end(), expected.begin()).first - result.begin();
+        std::cerr << name << ": mismatch at byte " << i << " (" << static_cast<int>(result[i])
+                  << " instead of " << static_cast<int>(expected[i]) << ")" << std::endl;
+        return false;
+    }
+
+    std::vector<sf::Uint8> randomPixels(std::size_t count)
+    {
+        std::vector<sf::Uint8> pixels(count * 4);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<sf::Uint8>(std::rand());
+        return pixels;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Check that the image kernels give the same results as
+/// the original sf::Image loops, then compare their speed
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Exhaustive check of the blending against the original formula
+    {
+        std::vector<sf::Uint8> source(256 * 256 * 4);
+        std::vector<sf::Uint8> destination(256 * 256 * 4);
+        for (int s = 0; s < 256; ++s)
+        {
+            for (std::size_t i = 0; i < 256 * 256; ++i)
+            {
+                source[i * 4 + 0] = source[i * 4 + 1] = source[i * 4 + 2] = static_cast<sf::Uint8>(s);
+                source[i * 4 + 3] = static_cast<sf::Uint8>(i / 256);
+                destination[i * 4 + 0] = destination[i * 4 + 1] = destination[i * 4 + 2] = destination[i * 4 + 3] = static_cast<sf::Uint8>(i % 256);
+            }
+
+            std::vector<sf::Uint8> expected(destination);
+            std::vector<sf::Uint8> result(destination);
+            blendReference(&source[0], &expected[0], 256 * 256);
+            sf::priv::blendPixels(&source[0], &result[0], 256 * 256);
+            if (!check("blendPixels", result, expected))
+                return EXIT_FAILURE;
+        }
+    }
+
+    // Odd count, to exercise the remainders of the vector loops
+    const std::size_t count = 1024 * 1024 + 7;
+    const int iterations = 20;
+    const std::vector<sf::Uint8> source = randomPixels(count);
+    const std::vector<sf::Uint8> original = randomPixels(count);
+    std::vector<sf::Uint8> expected(original);
+    std::vector<sf::Uint8> result(original);
+
+    std::cout << "Processing " << count << " pixels:" << std::endl;
+
+    // Blending
+    blendReference(&source[0], &expected[0], count);
+    sf::priv::blendPixels(&source[0], &result[0], count);
+    if (!check("blendPixels", result, expected))
+        return EXIT_FAILURE;
+    report("blend  ", measure([&]() { blendReference(&source[0], &expected[0], count); }, iterations),
+                      measure([&]() { sf::priv::blendPixels(&source[0], &result[0], count); }, iterations));
+
+    // Masking; make a few pixels match the color
+    const sf::Uint8 color[4] = {source[0], source[1], source[2], source[3]};
+    expected = result = source;
+    for (std::size_t i = 0; i < count; i += 5)
+        std::memcpy(&expected[i * 4], color, 4);
+    result = expected;
+    maskReference(&expected[0], count, color, 17);
+    sf::priv::maskPixels(&result[0], count, color, 17);
+    if (!check("maskPixels", result, expected))
+        return EXIT_FAILURE;
+    report("mask   ", measure([&]() { maskReference(&expected[0], count, color, 17); }, iterations),
+                      measure([&]() { sf::priv::maskPixels(&result[0], count, color, 17); }, iterations));
+
+    // Reversing, with every remainder of the vector loops
+    for (std::size_t n = 1; n < 40; ++n)
+    {
+        expected = result = source;
+        reverseReference(&expected[0], n);
+        sf::priv::reversePixels(&result[0], n);
+        if (!check("reversePixels", result, expected))
+            return EXIT_FAILURE;
+    }
+    expected = result = source;
+    reverseReference(&expected[0], count);
+    sf::priv::reversePixels(&result[0], count);
+    if (!check("reversePixels", result, expected))
+        return EXIT_FAILURE;
+    report("reverse", measure([&]() { reverseReference(&expected[0], count); }, iterations),
+                      measure([&]() { sf::priv::reversePixels(&result[0], count); }, iterations));
+
+    // Swapping
+    std::size_t half = count / 2;
+    expected = result = source;
+    swapReference(&expected[0], &expected[half * 4], half);
+    sf::priv::swapPixels(&result[0], &result[half * 4], half);
+    if (!check("swapPixels", result, expected))
+        return EXIT_FAILURE;
+    report("swap   ", measure([&]() { swapReference(&expected[0], &expected[half * 4], half); }, iterations),
+                      measure([&]() { sf::priv::swapPixels(&result[0], &result[half * 4], half); }, iterations));
+
+    // Splitting a large blend between threads must not change the result
+    const unsigned int width = 1024;
+    const unsigned int rows = static_cast<unsigned int>(count / width);
+    expected = result = original;
+    blendReference(&source[0], &expected[0], width * rows);
+    BlendTask task(&source[0], &result[0], width);
+    sf::priv::processRows(task, rows, width, 4);
+    if (!check("processRows", result, expected))
+        return EXIT_FAILURE;
+    report("blend, 4 threads", measure([&]() { blendReference(&source[0], &expected[0], width * rows); }, iterations),
+                               measure([&]() { sf::priv::processRows(task, rows, width, 4); }, iterations));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <XPF/Graphics/VertexTransform.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Layout of sf::Vertex: position, color, texture coordinates
+    struct TestVertex
+    {
+        float         x, y;
+        unsigned char color[4];
+        float         u, v;
+    };
+
+    // Scalar loop used before the vectorized kernels (sf::Transform::transformPoint)
+    void transformReference(const float* m, const TestVertex* input, TestVertex* output, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float x = input[i].x;
+            float y = input[i].y;
+            output[i].x = m[0] * x + m[4] * y + m[12];
+            output[i].y = m[1] * x + m[5] * y + m[13];
+        }
+    }
+
+    template <typename F>
+    double measure(F function, int iterations)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            function();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Check that sf::priv::transformPositions gives the same
+/// results as the scalar loop, then compare their speed
+////////////////////////////////////////////////////////////
+int main()
+{
+    const float matrix[16] = {0.8f, -0.6f, 0.f, 0.f,
+                              0.6f,  0.8f, 0.f, 0.f,
+                              0.f,   0.f,  1.f, 0.f,
+                              120.f, -35.5f, 0.f, 1.f};
+
+    // Odd count, to exercise the remainders of the vector loops
+    const std::size_t count = 100003;
+    std::vector<TestVertex> input(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        input[i].x = static_cast<float>(std::rand() % 20000) / 7.f - 1000.f;
+        input[i].y = static_cast<float>(std::rand() % 20000) / 3.f - 3000.f;
+    }
+
+    std::vector<TestVertex> expected(input);
+    std::vector<TestVertex> result(input);
+    transformReference(matrix, &input[0], &expected[0], count);
+    sf::priv::transformPositions(matrix, &input[0], &result[0], count, sizeof(TestVertex));
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if ((result[i].x != expected[i].x) || (result[i].y != expected[i].y))
+        {
+            std::cerr << "Mismatch at vertex " << i << ": (" << result[i].x << ", " << result[i].y
+                      << ") instead of (" << expected[i].x << ", " << expected[i].y << ")" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // In-place transformation must give the same results
+    std::vector<TestVertex> inPlace(input);
+    sf::priv::transformPositions(matrix, &inPlace[0], &inPlace[0], count, sizeof(TestVertex));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if ((inPlace[i].x != expected[i].x) || (inPlace[i].y != expected[i].y))
+        {
+            std::cerr << "In-place mismatch at vertex " << i << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const int iterations = 200;
+    double scalar = measure([&]() { transformReference(matrix, &input[0], &expected[0], count); }, iterations);
+    double kernel = measure([&]() { sf::priv::transformPositions(matrix, &input[0], &result[0], count, sizeof(TestVertex)); }, iterations);
+
+    std::cout << "Transforming " << count << " vertices:" << std::endl;
+    std::cout << "  scalar loop:        " << scalar << " us" << std::endl;
+    std::cout << "  transformPositions: " << kernel << " us (x" << scalar / kernel << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}